@@ -26,7 +26,9 @@
  */
 
 #include <algorithm>
-#include <queue>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 #include "ft-client.hpp"
 #include "logger/logger.hpp"
@@ -40,6 +42,13 @@ Client::Client(std::shared_ptr<ndnc::posix::Consumer> consumer,
 
 Client::~Client() {
     this->stop();
+
+    // Keep the checkpoints of interrupted transfers
+    std::lock_guard<std::mutex> lock(filesMtx_);
+    for (auto &[name, output] : outputs_) {
+        closeOutput(output);
+    }
+    outputs_.clear();
 }
 
 bool Client::canContinue() {
@@ -50,21 +59,114 @@ void Client::stop() {
     stop_ = true;
 }
 
-void Client::openFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
-    auto id = consumer_->registerConsumer();
-    files_->emplace(metadata->getVersionedName().toUri(), id);
+bool Client::openFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata,
+                      const std::string &destination) {
+    auto name = metadata->getVersionedName().toUri();
+    FileOutput output{};
+
+    if (!destination.empty()) {
+        output.writer = std::make_shared<FileWriter>(
+            destination, metadata->getFileSize(), metadata->getSegmentSize(),
+            options_.directIO);
+
+        if (!output.writer->open()) {
+            error_ = true;
+            return false;
+        }
+
+        if (options_.resume) {
+            output.bitmap = std::make_shared<SegmentBitmap>(
+                destination + ".ndncft-resume", name,
+                metadata->getFinalBlockID() + 1);
+
+            if (output.bitmap->load()) {
+                LOG_INFO("resuming %s with %lu of %lu segments",
+                         destination.c_str(), output.bitmap->count(),
+                         output.bitmap->size());
+            }
+        }
+    }
+
+    // The consumer id is registered on first whole-file request, ranges
+    // use their own ids
+    std::lock_guard<std::mutex> lock(filesMtx_);
+    files_->emplace(name, 0);
+    if (output.writer != nullptr) {
+        outputs_.emplace(name, output);
+    }
+
+    return true;
 }
 
 void Client::closeFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
-    auto it = files_->find(metadata->getVersionedName().toUri());
+    auto name = metadata->getVersionedName().toUri();
+
+    std::lock_guard<std::mutex> lock(filesMtx_);
+    auto it = files_->find(name);
 
     if (it == files_->end()) {
         LOG_DEBUG("trying to close an unopened file");
         return;
     }
 
-    consumer_->unregisterConsumer(it->second);
+    if (it->second != 0) {
+        consumer_->unregisterConsumer(it->second);
+    }
     files_->erase(it);
+
+    auto oit = outputs_.find(name);
+    if (oit != outputs_.end()) {
+        if (!closeOutput(oit->second)) {
+            error_ = true;
+        }
+        outputs_.erase(oit);
+    }
+}
+
+uint64_t Client::getResumedByteCount(
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
+    std::lock_guard<std::mutex> lock(filesMtx_);
+
+    auto it = outputs_.find(metadata->getVersionedName().toUri());
+    if (it == outputs_.end() || it->second.bitmap == nullptr) {
+        return 0;
+    }
+
+    auto &bitmap = it->second.bitmap;
+    auto bytes = bitmap->count() * metadata->getSegmentSize();
+
+    // The last segment may be shorter
+    auto last = metadata->getFinalBlockID();
+    if (bitmap->test(last)) {
+        bytes -= (last + 1) * metadata->getSegmentSize() -
+                 metadata->getFileSize();
+    }
+
+    return bytes;
+}
+
+bool Client::checkpoint(const FileOutput &output) {
+    // Segments set after the snapshot are saved by the next checkpoint
+    auto words = output.bitmap->snapshot();
+    return output.writer->sync() && output.bitmap->save(words);
+}
+
+bool Client::closeOutput(const FileOutput &output) {
+    if (output.bitmap == nullptr) {
+        return output.writer->close();
+    }
+
+    if (output.bitmap->count() < output.bitmap->size()) {
+        auto ok = checkpoint(output);
+        return output.writer->close() && ok;
+    }
+
+    auto ok = output.writer->close();
+    if (ok) {
+        output.bitmap->remove();
+    }
+
+    return ok;
 }
 
 void Client::listFile(std::string path,
@@ -97,9 +199,107 @@ void Client::listFile(std::string path,
 void Client::listDir(
     std::string root,
     std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
-    std::shared_ptr<ndnc::posix::FileMetadata> metadata(nullptr);
     all.clear();
 
+    listDir(root, [&all](std::shared_ptr<ndnc::posix::FileMetadata> md) {
+        all.push_back(md);
+    });
+
+    sortEntries(all);
+}
+
+void Client::listDirRecursive(
+    std::string root,
+    std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
+    listDirRecursive(root,
+                     [&all](std::shared_ptr<ndnc::posix::FileMetadata> md) {
+                         all.push_back(md);
+                     });
+
+    sortEntries(all);
+}
+
+void Client::listDir(std::string root, OnEntry onEntry) {
+    auto id = consumer_->registerConsumer();
+    listDir(root, id, onEntry);
+    consumer_->unregisterConsumer(id);
+}
+
+void Client::listDirRecursive(std::string root, OnEntry onEntry) {
+    std::deque<std::string> dirs{root};
+    size_t busy = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    auto worker = [&]() {
+        auto id = consumer_->registerConsumer();
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true) {
+            // Wait for work while other workers may still discover subdirs
+            while (dirs.empty() && busy > 0 && canContinue()) {
+                cv.wait_for(lock, std::chrono::milliseconds(100));
+            }
+
+            if (dirs.empty() || !canContinue()) {
+                break;
+            }
+
+            auto dir = dirs.front();
+            dirs.pop_front();
+            ++busy;
+
+            lock.unlock();
+            listDir(dir, id,
+                    [&](std::shared_ptr<ndnc::posix::FileMetadata> md) {
+                        std::lock_guard<std::mutex> guard(mutex);
+
+                        if (md->isDir()) {
+                            dirs.push_back(ndnc::posix::rdrDirUri(
+                                md->getVersionedName(),
+                                options_.consumer.prefix));
+                            cv.notify_one();
+                        }
+
+                        onEntry(md);
+                    });
+            lock.lock();
+
+            --busy;
+        }
+
+        lock.unlock();
+        cv.notify_all();
+
+        consumer_->unregisterConsumer(id);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::max<size_t>(options_.listConcurrency, 1);
+         ++i) {
+        workers.push_back(std::thread(worker));
+    }
+
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+bool Client::listDir(const std::string &root, uint64_t id, OnEntry onEntry) {
+    std::vector<std::string> paths;
+
+    if (!getDirListing(root, id, paths)) {
+        return false;
+    }
+
+    return getEntriesMetadata(paths, id, onEntry);
+}
+
+bool Client::getDirListing(const std::string &root, uint64_t id,
+                           std::vector<std::string> &paths) {
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata(nullptr);
+
     {
         // Get list dir Metadata
         auto interest = std::make_shared<ndn::Interest>(
@@ -109,146 +309,186 @@ void Client::listDir(
         interest->setCanBePrefix(true);
         interest->setMustBeFresh(true);
 
-        auto data = consumer_->syncRequestDataFor(std::move(interest), 0);
+        auto data = consumer_->syncRequestDataFor(std::move(interest), id);
 
         if (data == nullptr || !data->hasContent()) {
             LOG_ERROR("invalid data");
             error_ = true;
-            return;
+            return false;
         }
 
         if (data->getContentType() == ndn::tlv::ContentType_Nack) {
             LOG_ERROR("unable to list dir: '%s'", root.c_str());
-            return;
+            return false;
         }
 
         metadata =
             std::make_shared<ndnc::posix::FileMetadata>(data->getContent());
     }
 
-    if (metadata == nullptr) {
-        LOG_ERROR("unable to list dir: '%s'", root.c_str());
-        return;
-    }
-
     if (!metadata->isDir()) {
         LOG_ERROR("request to list dir on a file path: '%s'", root.c_str());
-        return;
+        return false;
     }
 
-    uint8_t *byteContent = nullptr;
-    uint64_t byteContentOffset = 0;
+    // Listing segments may arrive in any order; keep them by segment number
+    std::vector<ndn::Block> segments(1);
 
-    {
-        // Get all list dir content
-        for (uint64_t i = 0, contentFinalBlockId = 0; i <= contentFinalBlockId;
-             ++i) {
-            auto interest = std::make_shared<ndn::Interest>(
-                metadata->getVersionedName().appendSegment(i));
+    auto onSegment = [&](const ndn::Data &data) {
+        if (!data.hasContent() ||
+            data.getContentType() == ndn::tlv::ContentType_Nack) {
+            LOG_FATAL("unable to get list dir content '%s'", root.c_str());
+            return false;
+        }
 
-            auto data = consumer_->syncRequestDataFor(std::move(interest), 0);
+        if (!data.getFinalBlock() || !data.getFinalBlock()->isSegment() ||
+            !data.getName().at(-1).isSegment()) {
+            LOG_ERROR("dir list data content FinalBlockId is not a segment");
+            return false;
+        }
 
-            if (data == nullptr || !data->hasContent()) {
-                LOG_ERROR("invalid data");
-                error_ = true;
-                return;
-            }
+        auto segment = data.getName().at(-1).toSegment();
+        if (segment >= segments.size()) {
+            LOG_ERROR("dir list data segment out of range");
+            return false;
+        }
 
-            if (data->getContentType() == ndn::tlv::ContentType_Nack) {
-                LOG_FATAL("unable to get list dir content '%s'", root.c_str());
-                error_ = true;
-                return;
-            } else {
-                if (!data->getFinalBlock()->isSegment()) {
-                    LOG_ERROR(
-                        "dir list data content FinalBlockId is not a segment");
-                    error_ = true;
-                    return;
-                } else {
-                    contentFinalBlockId = data->getFinalBlock()->toSegment();
-                }
-            }
+        segments[segment] = data.getContent();
+        return true;
+    };
 
-            if (byteContent == nullptr) {
-                byteContent =
-                    (uint8_t *)malloc(8800 * (contentFinalBlockId + 1));
+    {
+        // The first segment carries the FinalBlockId of the listing
+        auto data = consumer_->syncRequestDataFor(
+            std::make_shared<ndn::Interest>(
+                metadata->getVersionedName().appendSegment(0)),
+            id);
 
-                if (byteContent == nullptr) {
-                    LOG_FATAL("unable to allocate memory for retrieving "
-                              "dir list content");
-                    error_ = true;
-                    return;
-                }
-            }
+        if (data == nullptr || !onSegment(*data)) {
+            error_ = true;
+            return false;
+        }
+
+        segments.resize(data->getFinalBlock()->toSegment() + 1);
+    }
+
+    if (segments.size() > 1) {
+        // Pipeline all remaining segments
+        std::vector<std::shared_ptr<ndn::Interest>> interests;
+        interests.reserve(segments.size() - 1);
+
+        for (uint64_t i = 1; i < segments.size(); ++i) {
+            interests.emplace_back(std::make_shared<ndn::Interest>(
+                metadata->getVersionedName().appendSegment(i)));
+        }
 
-            memcpy(byteContent + byteContentOffset, data->getContent().value(),
-                   data->getContent().value_size());
-            byteContentOffset += data->getContent().value_size();
+        if (!consumer_->syncRequestDataFor(std::move(interests), id,
+                                           onSegment)) {
+            error_ = true;
+            return false;
         }
     }
 
-    // Parse dir list byteContent to a list of paths
-    std::vector<std::string> content = {};
-    for (uint64_t i = 0, j = 0;
-         j <= byteContentOffset && i <= byteContentOffset; ++j) {
-        if (byteContent[j] != '\0') {
-            continue;
+    // Parse dir list content to a list of paths
+    std::string content;
+    for (auto &segment : segments) {
+        content.append((const char *)segment.value(), segment.value_size());
+    }
+
+    auto prefix = root.back() == '/' ? root : root + "/";
+
+    for (size_t i = 0; i < content.size();) {
+        auto j = content.find('\0', i);
+        if (j == std::string::npos) {
+            j = content.size();
         }
 
-        if (byteContent[i] == '\0') {
+        if (j == i) {
             break;
         }
 
-        auto suffix = std::string((const char *)(byteContent + i), j - i);
-        auto prefix = root.back() == '/' ? root : root + "/";
-
-        content.push_back(prefix + suffix);
+        paths.push_back(prefix + content.substr(i, j - i));
         i = j + 1;
     }
 
-    free(byteContent);
+    return true;
+}
 
-    // Request Metadata for all files in the directory
-    for (auto file : content) {
-        metadata = nullptr;
-        listFile(file, metadata);
+bool Client::getEntriesMetadata(const std::vector<std::string> &paths,
+                                uint64_t id, OnEntry onEntry) {
+    size_t next = 0;
+    size_t pending = 0;
+
+    std::vector<std::shared_ptr<ndn::Interest>> interests;
+    size_t pushed = 0;
+
+    // Keep at most listWindow metadata requests in flight. The Interests
+    // are pushed as credits become available, interleaved with popping
+    // their responses on this thread
+    auto request = [&](size_t n) {
+        if (pushed == interests.size()) {
+            interests.clear();
+            pushed = 0;
+        }
 
-        if (metadata == nullptr) {
-            LOG_ERROR("null metadata");
-            continue;
-        } else {
-            all.push_back(metadata);
+        for (; n > 0 && next < paths.size(); --n, ++next) {
+            auto interest = std::make_shared<ndn::Interest>(
+                ndnc::posix::rdrDiscoveryNameFileRetrieval(
+                    paths[next], options_.consumer.prefix));
+
+            interest->setCanBePrefix(true);
+            interest->setMustBeFresh(true);
+
+            interests.emplace_back(std::move(interest));
+            ++pending;
         }
-    }
-}
+    };
 
-void Client::listDirRecursive(
-    std::string root,
-    std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
-    std::queue<std::string> paths;
-    paths.push(root);
+    request(std::max<size_t>(options_.listWindow, 1));
+
+    std::vector<std::shared_ptr<ndn::Data>> pkts;
 
-    while (!paths.empty()) {
-        auto path = paths.front();
-        paths.pop();
+    while (pending > 0 && this->canContinue()) {
+        if (!consumer_->tryRequestDataFor(interests, pushed, id)) {
+            error_ = true;
+            return false;
+        }
 
-        std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> metadata{};
-        listDir(path, metadata);
+        pkts.resize(std::min<size_t>(pending, 64));
 
-        if (metadata.empty()) {
+        auto npkts = consumer_->getData(pkts, id);
+        if (npkts == 0) {
             continue;
         }
 
-        for (auto md : metadata) {
-            all.push_back(md);
+        pending -= npkts;
 
-            if (md->isDir()) {
-                paths.push(ndnc::posix::rdrDirUri(md->getVersionedName(),
-                                                  options_.consumer.prefix));
+        for (size_t i = 0; i < npkts; ++i) {
+            if (pkts[i] == nullptr) {
+                LOG_FATAL("pipeline error on list dir");
+                error_ = true;
+                return false;
             }
+
+            if (!pkts[i]->hasContent() ||
+                pkts[i]->getContentType() == ndn::tlv::ContentType_Nack) {
+                LOG_ERROR("unable to list file '%s'",
+                          pkts[i]->getName().toUri().c_str());
+                continue;
+            }
+
+            onEntry(std::make_shared<ndnc::posix::FileMetadata>(
+                pkts[i]->getContent()));
         }
+
+        request(npkts);
     }
 
+    return pending == 0;
+}
+
+void Client::sortEntries(
+    std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
     std::sort(all.begin(), all.end(),
               [this](std::shared_ptr<ndnc::posix::FileMetadata> lhs,
                      std::shared_ptr<ndnc::posix::FileMetadata> rhs) {
@@ -259,55 +499,115 @@ void Client::listDirRecursive(
               });
 }
 
+void Client::openRange(FileRange &range) {
+    range.id = consumer_->registerConsumer();
+}
+
+void Client::closeRange(FileRange &range) {
+    if (range.id != 0) {
+        consumer_->unregisterConsumer(range.id);
+        range.id = 0;
+    }
+}
+
+Client::FileOutput Client::getOutput(const std::string &name) {
+    std::lock_guard<std::mutex> lock(filesMtx_);
+
+    auto it = outputs_.find(name);
+    return it != outputs_.end() ? it->second : FileOutput{};
+}
+
+size_t Client::getSegmentLength(
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata, uint64_t segment) {
+    // Only the last segment may be shorter
+    auto offset = segment * metadata->getSegmentSize();
+
+    if (offset >= metadata->getFileSize()) {
+        return 0;
+    }
+
+    return std::min<uint64_t>(metadata->getSegmentSize(),
+                              metadata->getFileSize() - offset);
+}
+
+FileRange
+Client::getFileRange(std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
+    std::lock_guard<std::mutex> lock(filesMtx_);
+
+    auto &id = files_->at(metadata->getVersionedName().toUri());
+    if (id == 0) {
+        id = consumer_->registerConsumer();
+    }
+
+    return FileRange{metadata, 0, metadata->getFinalBlockID(), id};
+}
+
 void Client::requestFileContent(
     std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
-    uint64_t npkts = 64;
-    uint64_t id = files_->at(metadata->getVersionedName().toUri());
+    requestFileContent(getFileRange(metadata));
+}
 
-    for (uint64_t segmentNo = 0;
-         segmentNo <= metadata->getFinalBlockID() && this->canContinue();) {
+void Client::receiveFileContent(
+    NotifyProgressStatus onProgress,
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
+    receiveFileContent(onProgress, getFileRange(metadata));
+}
 
-        // if (m_pipeline->getQueuedInterestsCount() > 65536) {
-        //     // backoff; plenty of work to be done by the pipeline
-        //     continue;
-        // }
+void Client::requestFileContent(const FileRange &range) {
+    uint64_t npkts = 64;
+    auto &metadata = range.metadata;
+    auto bitmap = getOutput(metadata->getVersionedName().toUri()).bitmap;
 
+    for (uint64_t segmentNo = range.first;
+         segmentNo <= range.last && this->canContinue();) {
         std::vector<std::shared_ptr<ndn::Interest>> pkts;
         pkts.reserve(npkts);
 
-        for (uint64_t nextSegment = segmentNo, n = 0;
-             nextSegment <= metadata->getFinalBlockID() && n < npkts;
-             ++nextSegment, ++n) {
+        for (; segmentNo <= range.last && pkts.size() < npkts; ++segmentNo) {
+
+            // Received by an earlier run
+            if (bitmap != nullptr && bitmap->test(segmentNo)) {
+                continue;
+            }
 
             auto interest = std::make_shared<ndn::Interest>(
                 metadata->getVersionedName().deepCopy().appendSegment(
-                    nextSegment));
+                    segmentNo));
 
             pkts.emplace_back(std::move(interest));
         }
 
-        if (!consumer_->asyncRequestDataFor(std::move(pkts), id)) {
+        if (pkts.empty()) {
+            break;
+        }
+
+        if (!consumer_->asyncRequestDataFor(std::move(pkts), range.id)) {
             error_ = true;
             return;
         }
-
-        segmentNo += npkts;
     }
 }
 
-void Client::receiveFileContent(
-    NotifyProgressStatus onProgress,
-    std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
+void Client::receiveFileContent(NotifyProgressStatus onProgress,
+                                const FileRange &range) {
     uint64_t bytesCount = 0;
     uint64_t segmentsCount = 0;
-    uint64_t id = files_->at(metadata->getVersionedName().toUri());
 
-    while (this->canContinue() &&
-           segmentsCount <= metadata->getFinalBlockID()) {
+    auto output = getOutput(range.metadata->getVersionedName().toUri());
+    auto &writer = output.writer;
+    auto &bitmap = output.bitmap;
+
+    // Segments received by an earlier run are not requested again
+    uint64_t expected = range.last - range.first + 1;
+    if (bitmap != nullptr) {
+        expected -= bitmap->count(range.first, range.last);
+    }
+
+    while (this->canContinue() && segmentsCount < expected) {
 
         size_t npkts = 16;
         std::vector<std::shared_ptr<ndn::Data>> pkts(npkts);
-        npkts = consumer_->getData(pkts, id);
+        npkts = consumer_->getData(pkts, range.id);
 
         if (npkts == 0) {
             continue;
@@ -320,7 +620,37 @@ void Client::receiveFileContent(
                 return;
             }
 
-            bytesCount += pkts[i]->getContent().value_size();
+            auto &content = pkts[i]->getContent();
+            auto segment = pkts[i]->getName().at(-1).toSegment();
+
+            // A Nack or a short segment would be written and checkpointed
+            // as received, leaving a corrupt file that resume never repairs
+            if (pkts[i]->getContentType() == ndn::tlv::ContentType_Nack ||
+                content.value_size() !=
+                    getSegmentLength(range.metadata, segment)) {
+                LOG_FATAL("invalid segment %lu of %s", segment,
+                          range.metadata->getVersionedName().toUri().c_str());
+                error_ = true;
+                return;
+            }
+
+            if (writer != nullptr && !writer->write(segment, content.value(),
+                                                    content.value_size())) {
+                LOG_FATAL("unable to write %s", writer->getPath().c_str());
+                error_ = true;
+                return;
+            }
+
+            if (bitmap != nullptr) {
+                bitmap->set(segment);
+            }
+
+            bytesCount += content.value_size();
+        }
+
+        if (bitmap != nullptr && bitmap->shouldCheckpoint() &&
+            !checkpoint(output)) {
+            LOG_WARN("unable to checkpoint %s", writer->getPath().c_str());
         }
 
         segmentsCount += npkts;
@@ -28,9 +28,15 @@
 #ifndef NDNC_APP_FILE_TRANSFER_CLIENT_FT_CLIENT_HPP
 #define NDNC_APP_FILE_TRANSFER_CLIENT_FT_CLIENT_HPP
 
+#include <functional>
+#include <mutex>
+
 #include "lib/posix/consumer.hpp"
 
 #include "../common/ft-naming-scheme.hpp"
+#include "ft-file-writer.hpp"
+#include "ft-scheduler.hpp"
+#include "ft-segment-bitmap.hpp"
 #include "lib/posix/file-metadata.hpp"
 #include "lib/posix/file-rdr.hpp"
 
@@ -40,6 +46,13 @@ struct ClientOptions {
 
     std::vector<std::string> paths; // List of paths
     size_t streams = 1;             // The number of streams
+
+    size_t listConcurrency = 8; // Directories listed in parallel
+    size_t listWindow = 256;    // Entry metadata requests in flight per dir
+
+    std::string output = ""; // Destination directory. Empty drops content
+    bool directIO = true;    // Write with O_DIRECT when supported
+    bool resume = false;     // Checkpoint received segments and resume
 };
 }; // namespace ndnc::app::filetransfer
 
@@ -48,6 +61,14 @@ class Client : public std::enable_shared_from_this<Client> {
   public:
     using NotifyProgressStatus = std::function<void(uint64_t bytes)>;
 
+    /**
+     * @brief Invoked for each directory entry as soon as its metadata is
+     * resolved. Calls are serialized, but may come from different threads
+     *
+     */
+    using OnEntry =
+        std::function<void(std::shared_ptr<ndnc::posix::FileMetadata>)>;
+
   public:
     Client(std::shared_ptr<ndnc::posix::Consumer> consumer,
            ClientOptions options);
@@ -55,8 +76,22 @@ class Client : public std::enable_shared_from_this<Client> {
 
     void stop();
 
-    void openFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata);
+    /**
+     * @brief Prepare a file for transfer. With a destination, the received
+     * content is written to that path
+     *
+     */
+    bool openFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata,
+                  const std::string &destination = "");
     void closeFile(std::shared_ptr<ndnc::posix::FileMetadata> metadata);
+
+    /**
+     * @brief Get the number of bytes received by earlier runs of a resumed
+     * transfer
+     *
+     */
+    uint64_t
+    getResumedByteCount(std::shared_ptr<ndnc::posix::FileMetadata> metadata);
     void listFile(std::string path,
                   std::shared_ptr<ndnc::posix::FileMetadata> &metadata);
     void listDir(std::string root,
@@ -65,15 +100,72 @@ class Client : public std::enable_shared_from_this<Client> {
         std::string root,
         std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all);
 
+    /**
+     * @brief List a directory. Entries are streamed to onEntry in arrival
+     * order
+     *
+     */
+    void listDir(std::string root, OnEntry onEntry);
+
+    /**
+     * @brief List a directory tree. Subdirectories are expanded in parallel
+     * by listConcurrency workers and entries are streamed to onEntry in
+     * arrival order
+     *
+     */
+    void listDirRecursive(std::string root, OnEntry onEntry);
+
+    /**
+     * @brief Register a consumer for a range of an open file, so that ranges
+     * of the same file can be received by different streams
+     *
+     */
+    void openRange(FileRange &range);
+    void closeRange(FileRange &range);
+
     void
     requestFileContent(std::shared_ptr<ndnc::posix::FileMetadata> metadata);
     void
     receiveFileContent(NotifyProgressStatus onProgress,
                        std::shared_ptr<ndnc::posix::FileMetadata> metadata);
 
+    void requestFileContent(const FileRange &range);
+    void receiveFileContent(NotifyProgressStatus onProgress,
+                            const FileRange &range);
+
+  private:
+    /**
+     * @brief Where the content of an open file is written
+     *
+     */
+    struct FileOutput {
+        std::shared_ptr<FileWriter> writer;
+        // Received segments; nullptr unless resuming
+        std::shared_ptr<SegmentBitmap> bitmap;
+    };
+
   private:
     bool canContinue();
 
+    /**
+     * @brief Save the received segments once they are on disk
+     *
+     */
+    bool checkpoint(const FileOutput &output);
+    bool closeOutput(const FileOutput &output);
+    FileOutput getOutput(const std::string &name);
+    FileRange getFileRange(std::shared_ptr<ndnc::posix::FileMetadata> metadata);
+    size_t getSegmentLength(std::shared_ptr<ndnc::posix::FileMetadata> metadata,
+                            uint64_t segment);
+
+    bool listDir(const std::string &root, uint64_t id, OnEntry onEntry);
+    bool getDirListing(const std::string &root, uint64_t id,
+                       std::vector<std::string> &paths);
+    bool getEntriesMetadata(const std::vector<std::string> &paths,
+                            uint64_t id, OnEntry onEntry);
+    void sortEntries(
+        std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all);
+
   private:
     std::atomic_bool stop_;
     std::atomic_bool error_;
@@ -81,6 +173,8 @@ class Client : public std::enable_shared_from_this<Client> {
     std::shared_ptr<ndnc::posix::Consumer> consumer_;
     ClientOptions options_;
     std::shared_ptr<std::unordered_map<std::string, uint64_t>> files_;
+    std::unordered_map<std::string, FileOutput> outputs_;
+    std::mutex filesMtx_;
 };
 }; // namespace ndnc::app::filetransfer
 
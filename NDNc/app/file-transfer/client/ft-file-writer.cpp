@@ -0,0 +1,254 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <unistd.h>
+
+#include "ft-file-writer.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+// O_DIRECT buffer, offset and length alignment
+static const size_t DIRECT_IO_ALIGNMENT = 4096;
+// Unit of O_DIRECT writes; a multiple of the alignment
+static const size_t DIRECT_IO_CHUNK_SIZE = 1048576;
+
+FileWriter::FileWriter(std::string path, uint64_t size, size_t segmentSize,
+                       bool directIO)
+    : path_{path}, size_{size}, segmentSize_{segmentSize},
+      directIO_{directIO}, fd_{-1}, directFd_{-1} {
+}
+
+FileWriter::~FileWriter() {
+    close();
+}
+
+bool FileWriter::open() {
+    std::error_code ec;
+    auto parent = std::filesystem::path(path_).parent_path();
+
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+        if (ec) {
+            LOG_ERROR("unable to create directory %s: %s", parent.c_str(),
+                      ec.message().c_str());
+            return false;
+        }
+    }
+
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd_ < 0) {
+        LOG_ERROR("unable to open %s: %s", path_.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (size_ > 0 && ::fallocate(fd_, 0, 0, size_) != 0) {
+        // Not supported by every file system; the file grows on write
+        LOG_DEBUG("unable to preallocate %s: %s", path_.c_str(),
+                  strerror(errno));
+    }
+
+    if (directIO_) {
+        directFd_ = ::open(path_.c_str(), O_WRONLY | O_DIRECT);
+        if (directFd_ < 0) {
+            LOG_WARN("O_DIRECT not supported for %s; using the page cache",
+                     path_.c_str());
+        }
+    }
+
+    return true;
+}
+
+bool FileWriter::write(uint64_t segment, const uint8_t *data, size_t len) {
+    uint64_t offset = segment * segmentSize_;
+
+    if (offset + len > size_) {
+        LOG_ERROR("segment %lu out of the bounds of %s", segment,
+                  path_.c_str());
+        return false;
+    }
+
+    if (directFd_ < 0) {
+        return writeAt(fd_, data, len, offset);
+    }
+
+    // A segment may span two or more chunks
+    std::vector<std::pair<uint64_t, Chunk>> complete;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        while (len > 0) {
+            auto index = offset / DIRECT_IO_CHUNK_SIZE;
+            auto pos = offset % DIRECT_IO_CHUNK_SIZE;
+            auto n = std::min<size_t>(len, getChunkSize(index) - pos);
+
+            auto &chunk = chunks_[index];
+            if (chunk.buffer == nullptr) {
+                void *buffer = nullptr;
+                if (posix_memalign(&buffer, DIRECT_IO_ALIGNMENT,
+                                   DIRECT_IO_CHUNK_SIZE) != 0) {
+                    chunks_.erase(index);
+                    return false;
+                }
+                chunk.buffer = static_cast<uint8_t *>(buffer);
+            }
+
+            memcpy(chunk.buffer + pos, data, n);
+            chunk.filled += n;
+            chunk.ranges.emplace_back(pos, n);
+
+            if (chunk.filled >= getChunkSize(index)) {
+                complete.emplace_back(index, chunk);
+                chunks_.erase(index);
+            }
+
+            data += n;
+            len -= n;
+            offset += n;
+        }
+    }
+
+    bool ok = true;
+    for (auto &[index, chunk] : complete) {
+        // The last chunk is padded; close() truncates the file
+        auto n = (getChunkSize(index) + DIRECT_IO_ALIGNMENT - 1) /
+                 DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+        ok = writeAt(directFd_, chunk.buffer, n,
+                     index * DIRECT_IO_CHUNK_SIZE) &&
+             ok;
+        freeChunk(chunk);
+    }
+
+    return ok;
+}
+
+bool FileWriter::sync() {
+    bool ok = true;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // Write the received ranges of incomplete chunks once and release them.
+    // Their remaining segments start new chunks; a chunk that can no longer
+    // fill, e.g. one resumed with segments from an earlier run, is not held
+    // in memory until close()
+    for (auto &[index, chunk] : chunks_) {
+        ok = writeChunk(index, chunk) && ok;
+        freeChunk(chunk);
+    }
+    chunks_.clear();
+
+    if (::fdatasync(fd_) != 0) {
+        LOG_ERROR("unable to sync %s: %s", path_.c_str(), strerror(errno));
+        ok = false;
+    }
+
+    return ok;
+}
+
+bool FileWriter::close() {
+    bool ok = true;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto &[index, chunk] : chunks_) {
+        ok = writeChunk(index, chunk) && ok;
+        freeChunk(chunk);
+    }
+    chunks_.clear();
+
+    if (directFd_ >= 0) {
+        ::close(directFd_);
+        directFd_ = -1;
+    }
+
+    if (fd_ >= 0) {
+        if (::ftruncate(fd_, size_) != 0) {
+            LOG_ERROR("unable to truncate %s: %s", path_.c_str(),
+                      strerror(errno));
+            ok = false;
+        }
+
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    return ok;
+}
+
+size_t FileWriter::getChunkSize(uint64_t index) const {
+    return std::min<uint64_t>(DIRECT_IO_CHUNK_SIZE,
+                              size_ - index * DIRECT_IO_CHUNK_SIZE);
+}
+
+bool FileWriter::writeChunk(uint64_t index, Chunk &chunk) {
+    // Only the received ranges; the rest may hold data from earlier runs
+    bool ok = true;
+    for (auto &[pos, len] : chunk.ranges) {
+        ok = writeAt(fd_, chunk.buffer + pos, len,
+                     index * DIRECT_IO_CHUNK_SIZE + pos) &&
+             ok;
+    }
+
+    return ok;
+}
+
+bool FileWriter::writeAt(int fd, const uint8_t *data, size_t len,
+                         uint64_t offset) {
+    while (len > 0) {
+        auto n = ::pwrite(fd, data, len, offset);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            LOG_ERROR("unable to write %s: %s", path_.c_str(),
+                      strerror(errno));
+            return false;
+        }
+
+        data += n;
+        len -= n;
+        offset += n;
+    }
+
+    return true;
+}
+
+void FileWriter::freeChunk(Chunk &chunk) {
+    free(chunk.buffer);
+    chunk.buffer = nullptr;
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,108 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_CLIENT_FT_FILE_WRITER_HPP
+#define NDNC_APP_FILE_TRANSFER_CLIENT_FT_FILE_WRITER_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Writes the segments of one file at segment * segmentSize into a
+ * preallocated destination file. Segments may arrive out of order and from
+ * several threads.
+ *
+ * With direct I/O, segments are assembled into aligned chunks that are
+ * written with O_DIRECT once complete, so page cache writeback does not
+ * throttle the receive path. Chunks still incomplete on sync or close are
+ * written piecewise through the page cache and released. Without O_DIRECT
+ * support, e.g. on tmpfs, every segment is written through the page cache.
+ *
+ */
+class FileWriter {
+  private:
+    struct Chunk {
+        uint8_t *buffer = nullptr;
+        size_t filled = 0;
+        // Received byte ranges within the chunk
+        std::vector<std::pair<size_t, size_t>> ranges;
+    };
+
+  public:
+    FileWriter(std::string path, uint64_t size, size_t segmentSize,
+               bool directIO);
+    ~FileWriter();
+
+    /**
+     * @brief Create the file and its parent directories and preallocate it
+     *
+     */
+    bool open();
+
+    bool write(uint64_t segment, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Make every segment written so far durable. Incomplete chunks
+     * are written through the page cache and released
+     *
+     */
+    bool sync();
+
+    /**
+     * @brief Write the pending chunks and set the final file size
+     *
+     */
+    bool close();
+
+    const std::string &getPath() const {
+        return path_;
+    }
+
+  private:
+    size_t getChunkSize(uint64_t index) const;
+    bool writeChunk(uint64_t index, Chunk &chunk);
+    bool writeAt(int fd, const uint8_t *data, size_t len, uint64_t offset);
+    void freeChunk(Chunk &chunk);
+
+  private:
+    std::string path_;
+    uint64_t size_;
+    size_t segmentSize_;
+    bool directIO_;
+
+    int fd_;
+    int directFd_;
+
+    std::map<uint64_t, Chunk> chunks_;
+    std::mutex mutex_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_CLIENT_FT_FILE_WRITER_HPP
@@ -0,0 +1,96 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "ft-scheduler.hpp"
+
+namespace ndnc::app::filetransfer {
+uint64_t FileRange::getByteCount() const {
+    auto segmentSize = metadata->getSegmentSize();
+    auto bytes = (last - first + 1) * segmentSize;
+
+    // The last segment may be shorter
+    if (last == metadata->getFinalBlockID()) {
+        bytes -= (last + 1) * segmentSize - metadata->getFileSize();
+    }
+
+    return bytes;
+}
+
+std::vector<std::vector<FileRange>> scheduleFileRanges(
+    const std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &files,
+    size_t streams, uint64_t minRangeSegments) {
+    streams = std::max<size_t>(streams, 1);
+    minRangeSegments = std::max<uint64_t>(minRangeSegments, 1);
+
+    uint64_t total = 0;
+    for (auto &file : files) {
+        if (file->isFile()) {
+            total += file->getFileSize();
+        }
+    }
+
+    auto share = std::max<uint64_t>((total + streams - 1) / streams, 1);
+
+    std::vector<FileRange> ranges;
+    for (auto &file : files) {
+        if (!file->isFile()) {
+            continue;
+        }
+
+        auto nSegments = file->getFinalBlockID() + 1;
+        auto nRanges = (file->getFileSize() + share - 1) / share;
+        nRanges = std::clamp<uint64_t>(nRanges, 1,
+                                       std::max<uint64_t>(
+                                           nSegments / minRangeSegments, 1));
+
+        auto perRange = (nSegments + nRanges - 1) / nRanges;
+        for (uint64_t first = 0; first < nSegments; first += perRange) {
+            ranges.push_back(FileRange{
+                file, first, std::min(first + perRange, nSegments) - 1, 0});
+        }
+    }
+
+    std::stable_sort(ranges.begin(), ranges.end(),
+                     [](const FileRange &a, const FileRange &b) {
+                         return a.getByteCount() > b.getByteCount();
+                     });
+
+    std::vector<std::vector<FileRange>> schedule(streams);
+    std::vector<uint64_t> load(streams, 0);
+
+    for (auto &range : ranges) {
+        auto stream = std::min_element(load.begin(), load.end()) - load.begin();
+
+        load[stream] += range.getByteCount();
+        schedule[stream].push_back(range);
+    }
+
+    return schedule;
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,63 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_CLIENT_FT_SCHEDULER_HPP
+#define NDNC_APP_FILE_TRANSFER_CLIENT_FT_SCHEDULER_HPP
+
+#include <memory>
+#include <vector>
+
+#include "lib/posix/file-metadata.hpp"
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief A range of segments of one file, transferred by one stream
+ *
+ */
+struct FileRange {
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata;
+    uint64_t first = 0; // First segment
+    uint64_t last = 0;  // Last segment, inclusive
+    uint64_t id = 0;    // Consumer id, set by Client::openRange
+
+    uint64_t getByteCount() const;
+};
+
+/**
+ * @brief Split the files into segment ranges and assign the ranges to
+ * streams. Files larger than an even share of the total are split so that
+ * one large file keeps every stream busy, though never into ranges shorter
+ * than minRangeSegments. Ranges are assigned largest first to the least
+ * loaded stream (LPT) and each stream gets its ranges largest first
+ *
+ */
+std::vector<std::vector<FileRange>> scheduleFileRanges(
+    const std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &files,
+    size_t streams, uint64_t minRangeSegments = 4096);
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_CLIENT_FT_SCHEDULER_HPP
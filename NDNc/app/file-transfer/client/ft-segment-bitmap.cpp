@@ -0,0 +1,221 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ft-segment-bitmap.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+// Sidecar layout: magic, name length, name, segment count, bitmap words
+static const char CHECKPOINT_MAGIC[8] = {'N', 'D', 'N', 'C',
+                                         'F', 'T', 'R', '1'};
+// Minimum time between periodic checkpoints
+static const std::chrono::nanoseconds CHECKPOINT_INTERVAL =
+    std::chrono::seconds(1);
+
+static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static bool readAll(int fd, void *buf, size_t len) {
+    auto p = static_cast<uint8_t *>(buf);
+    while (len > 0) {
+        auto n = ::read(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void *buf, size_t len) {
+    auto p = static_cast<const uint8_t *>(buf);
+    while (len > 0) {
+        auto n = ::write(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+SegmentBitmap::SegmentBitmap(std::string path, std::string versionedName,
+                             uint64_t nSegments)
+    : path_{path}, versionedName_{versionedName}, nSegments_{nSegments},
+      nWords_{(nSegments + 63) / 64},
+      words_{std::make_unique<std::atomic<uint64_t>[]>(nWords_)},
+      nextCheckpoint_{now() + CHECKPOINT_INTERVAL.count()} {
+    for (size_t i = 0; i < nWords_; ++i) {
+        words_[i] = 0;
+    }
+}
+
+bool SegmentBitmap::load() {
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint64_t nameLength = 0, nSegments = 0;
+    std::string name;
+
+    bool ok = readAll(fd, magic, sizeof(magic)) &&
+              memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+              readAll(fd, &nameLength, sizeof(nameLength)) &&
+              nameLength == versionedName_.size();
+
+    if (ok) {
+        name.resize(nameLength);
+        ok = readAll(fd, name.data(), nameLength) && name == versionedName_ &&
+             readAll(fd, &nSegments, sizeof(nSegments)) &&
+             nSegments == nSegments_;
+    }
+
+    std::vector<uint64_t> words(nWords_);
+    if (ok) {
+        ok = readAll(fd, words.data(), nWords_ * sizeof(uint64_t));
+    }
+
+    ::close(fd);
+
+    if (!ok) {
+        LOG_INFO("ignoring stale checkpoint %s", path_.c_str());
+        return false;
+    }
+
+    for (size_t i = 0; i < nWords_; ++i) {
+        words_[i] = words[i];
+    }
+
+    return true;
+}
+
+void SegmentBitmap::set(uint64_t segment) {
+    if (segment < nSegments_) {
+        words_[segment / 64].fetch_or(uint64_t(1) << (segment % 64),
+                                      std::memory_order_relaxed);
+    }
+}
+
+bool SegmentBitmap::test(uint64_t segment) const {
+    if (segment >= nSegments_) {
+        return false;
+    }
+
+    return (words_[segment / 64].load(std::memory_order_relaxed) >>
+            (segment % 64)) &
+           1;
+}
+
+uint64_t SegmentBitmap::count() const {
+    uint64_t n = 0;
+    for (size_t i = 0; i < nWords_; ++i) {
+        n += __builtin_popcountll(words_[i].load(std::memory_order_relaxed));
+    }
+    return n;
+}
+
+uint64_t SegmentBitmap::count(uint64_t first, uint64_t last) const {
+    uint64_t n = 0;
+    for (auto segment = first; segment <= last && segment < nSegments_;
+         ++segment) {
+        n += test(segment);
+    }
+    return n;
+}
+
+bool SegmentBitmap::shouldCheckpoint() {
+    auto t = now();
+    auto next = nextCheckpoint_.load(std::memory_order_relaxed);
+
+    if (t < next) {
+        return false;
+    }
+
+    return nextCheckpoint_.compare_exchange_strong(
+        next, t + CHECKPOINT_INTERVAL.count());
+}
+
+std::vector<uint64_t> SegmentBitmap::snapshot() const {
+    std::vector<uint64_t> words(nWords_);
+    for (size_t i = 0; i < nWords_; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    return words;
+}
+
+bool SegmentBitmap::save(const std::vector<uint64_t> &words) {
+    auto tmp = path_ + ".tmp";
+
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("unable to open %s: %s", tmp.c_str(), strerror(errno));
+        return false;
+    }
+
+    uint64_t nameLength = versionedName_.size();
+    bool ok = writeAll(fd, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) &&
+              writeAll(fd, &nameLength, sizeof(nameLength)) &&
+              writeAll(fd, versionedName_.data(), nameLength) &&
+              writeAll(fd, &nSegments_, sizeof(nSegments_)) &&
+              writeAll(fd, words.data(), words.size() * sizeof(uint64_t)) &&
+              ::fdatasync(fd) == 0;
+
+    ::close(fd);
+
+    if (!ok || ::rename(tmp.c_str(), path_.c_str()) != 0) {
+        LOG_ERROR("unable to save checkpoint %s: %s", path_.c_str(),
+                  strerror(errno));
+        ::unlink(tmp.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void SegmentBitmap::remove() {
+    ::unlink(path_.c_str());
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,108 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_CLIENT_FT_SEGMENT_BITMAP_HPP
+#define NDNC_APP_FILE_TRANSFER_CLIENT_FT_SEGMENT_BITMAP_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Received segments of one file, checkpointed to a sidecar file so an
+ * interrupted transfer can resume. A checkpoint is only reused for the same
+ * versioned name
+ *
+ */
+class SegmentBitmap {
+  public:
+    SegmentBitmap(std::string path, std::string versionedName,
+                  uint64_t nSegments);
+
+    /**
+     * @brief Load the checkpoint
+     *
+     * @return true if a checkpoint for the same versioned name was loaded
+     */
+    bool load();
+
+    void set(uint64_t segment);
+    bool test(uint64_t segment) const;
+
+    /**
+     * @brief Get the number of received segments
+     *
+     */
+    uint64_t count() const;
+
+    /**
+     * @brief Get the number of received segments in [first, last]
+     *
+     */
+    uint64_t count(uint64_t first, uint64_t last) const;
+
+    uint64_t size() const {
+        return nSegments_;
+    }
+
+    /**
+     * @brief Claim the next periodic checkpoint. Returns true at most once
+     * per interval, to a single caller
+     *
+     */
+    bool shouldCheckpoint();
+
+    /**
+     * @brief Copy the current state, to be saved once the segments it holds
+     * are on disk
+     *
+     */
+    std::vector<uint64_t> snapshot() const;
+
+    /**
+     * @brief Atomically replace the sidecar file
+     *
+     */
+    bool save(const std::vector<uint64_t> &words);
+
+    void remove();
+
+  private:
+    std::string path_;
+    std::string versionedName_;
+    uint64_t nSegments_;
+
+    size_t nWords_;
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+
+    std::atomic<int64_t> nextCheckpoint_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_CLIENT_FT_SEGMENT_BITMAP_HPP
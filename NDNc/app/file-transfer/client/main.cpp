@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -70,6 +71,9 @@ static void programOptions(int argc, char *argv[],
     std::string pipelineType = "aimd";
     std::string prefix = ndnc::app::filetransfer::NDNC_NAME_PREFIX_DEFAULT;
 
+    description.add_options()(
+        "buffered-io", po::bool_switch(),
+        "Write the copied files through the page cache instead of O_DIRECT");
     description.add_options()(
         "copy,c",
         po::value<std::vector<std::string>>(&opts.paths)->multitoken(),
@@ -91,6 +95,12 @@ static void programOptions(int argc, char *argv[],
         "list,l",
         po::value<std::vector<std::string>>(&opts.paths)->multitoken(),
         "List one or more files or directories");
+    description.add_options()(
+        "metrics",
+        po::value<std::string>(&opts.consumer.metricsAddress)
+            ->default_value(opts.consumer.metricsAddress),
+        "Serve Prometheus metrics on this address, \"host:port\" or "
+        "\"unix:/path\". Empty disables the endpoint");
     description.add_options()(
         "mtu",
         po::value<size_t>(&opts.consumer.mtu)->default_value(opts.consumer.mtu),
@@ -99,6 +109,10 @@ static void programOptions(int argc, char *argv[],
         "name-prefix", po::value<std::string>(&prefix)->default_value(prefix),
         "The NDN Name prefix this consumer application publishes its "
         "Interest packets. Specify a non-empty string");
+    description.add_options()(
+        "output,o", po::value<std::string>(&opts.output),
+        "The directory where copied files are written. The tree of each "
+        "copied path is mirrored. If not set, the content is discarded");
     description.add_options()(
         "pipeline-type",
         po::value<std::string>(&pipelineType)->default_value(pipelineType),
@@ -110,13 +124,44 @@ static void programOptions(int argc, char *argv[],
                               "the initial ssthresh for `aimd` type");
     description.add_options()("recursive,r", po::bool_switch(&recursive),
                               "Set recursive copy or list of directories");
+    description.add_options()(
+        "max-pending",
+        po::value<size_t>(&opts.consumer.maxPendingInterests)
+            ->default_value(opts.consumer.maxPendingInterests),
+        "The maximum number of Interests queued or in flight across all "
+        "streams. Streams wait for credits once it is reached");
     description.add_options()(
         "repeat", po::value<int>(&repeat)->default_value(0),
         "The number of times to repeat the copy operation");
+    description.add_options()(
+        "resume", po::bool_switch(&opts.resume),
+        "Checkpoint the received segments of each copied file next to it and "
+        "request only the missing ones when the copy is run again. Requires "
+        "--output");
     description.add_options()(
         "streams,s",
         po::value<size_t>(&opts.streams)->default_value(opts.streams),
         "The number of streams. Specify a positive integer between 1 and 16");
+    description.add_options()(
+        "trace-file",
+        po::value<std::string>(&opts.consumer.traceFile)
+            ->default_value(opts.consumer.traceFile),
+        "Write the traced Interests to this file as Chrome trace JSON, for "
+        "chrome://tracing or Perfetto. Requires --trace-sampling");
+    description.add_options()(
+        "trace-sampling",
+        po::value<size_t>(&opts.consumer.traceSampling)
+            ->default_value(opts.consumer.traceSampling),
+        "Trace one in every N Interests through the request queue, network "
+        "and response queue, and log per-stage latencies at exit. Zero "
+        "disables tracing");
+    description.add_options()(
+        "verify-threads",
+        po::value<size_t>(&opts.consumer.verifyThreads)
+            ->default_value(opts.consumer.verifyThreads),
+        "The number of threads verifying the signature of received Data "
+        "packets. Packets failing verification are requested again. Specify "
+        "0 to disable verification");
 
     description.add_options()("help,h", "Print this help message and exit");
 
@@ -148,6 +193,12 @@ static void programOptions(int argc, char *argv[],
         }
     }
 
+    if (opts.consumer.maxPendingInterests == 0) {
+        std::cerr << "ERROR: max-pending must be a positive integer\n\n";
+        programUsage(std::cout, app, description);
+        exit(2);
+    }
+
     if (vm.count("gqlserver") > 0) {
         if (opts.consumer.gqlserver.empty()) {
             std::cerr << "ERROR: empty gqlserver argument value\n\n";
@@ -219,6 +270,49 @@ static void programOptions(int argc, char *argv[],
             repeat = 0;
         }
     }
+
+    opts.directIO = !vm["buffered-io"].as<bool>();
+
+    if (vm.count("output") > 0) {
+        if (opts.output.empty()) {
+            std::cerr << "ERROR: empty output argument value\n\n";
+            programUsage(std::cout, app, description);
+            exit(2);
+        }
+
+        if (repeat > 0) {
+            std::cerr << "ERROR: --output cannot be used with --repeat\n\n";
+            programUsage(std::cout, app, description);
+            exit(2);
+        }
+    }
+
+    if (opts.resume && opts.output.empty()) {
+        std::cerr << "ERROR: --resume requires --output\n\n";
+        programUsage(std::cout, app, description);
+        exit(2);
+    }
+}
+
+/**
+ * @brief Map a copied path to the output directory, keeping the last
+ * component of the root it was listed from, as cp -r does
+ *
+ */
+static std::string getDestination(const std::string &output,
+                                  const std::string &root,
+                                  const std::string &path) {
+    auto base = root;
+    while (base.size() > 1 && base.back() == '/') {
+        base.pop_back();
+    }
+
+    auto pos = base.rfind('/');
+    auto parent = pos == std::string::npos ? "" : base.substr(0, pos);
+
+    auto relative = std::filesystem::path(path.substr(parent.size()));
+    return (std::filesystem::path(output) / relative.relative_path())
+        .string();
 }
 
 static void programTerminate() {
@@ -231,6 +325,9 @@ static void programTerminate() {
             }
         }
     }
+
+    // Submit the last interval while the consumer is still around
+    reporter.reset();
 }
 
 static void signalHandler(sig_atomic_t signum) {
@@ -279,12 +376,50 @@ int main(int argc, char *argv[]) {
 
     // Init influxdb reporter
     reporter = std::make_unique<ndnc::MeasurementsReporter>(
-        32, opts.consumer.to_string());
-    reporter->init("ft-client", opts.consumer.influxdb);
+        16, opts.consumer.to_string());
+    reporter->init("ft-client", opts.consumer.influxdb, []() {
+        auto counters = consumer->getCounters();
+        return ndnc::MeasurementsReporter::Sample{
+            static_cast<int64_t>(counters.tx),
+            static_cast<int64_t>(counters.rx),
+            counters.getAverageDelay().count()};
+    });
 
-    // Get all file information
+    uint64_t totalByteCount = 0;
+    uint64_t totalFileCount = 0;
+
+    // Get all file information. Entries are printed as they are resolved
     std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> metadata{};
+    std::vector<std::string> destinations{};
+    std::string root;
+
+    auto onEntry = [&](std::shared_ptr<ndnc::posix::FileMetadata> md) {
+        metadata.push_back(md);
+
+        auto path = md->isFile() ? ndnc::posix::rdrFileUri(
+                                       md->getVersionedName(),
+                                       opts.consumer.prefix)
+                                 : ndnc::posix::rdrDirUri(
+                                       md->getVersionedName(),
+                                       opts.consumer.prefix);
+        destinations.push_back(
+            opts.output.empty() ? ""
+                                : getDestination(opts.output, root, path));
+
+        if (md->isFile()) {
+            std::cout << path << "\n";
+            totalByteCount += md->getFileSize();
+            totalFileCount += 1;
+        } else if (list) {
+            std::cout << path << "\n";
+            totalFileCount += 1;
+        }
+    };
+
+    std::cout << "\n";
     for (auto path : opts.paths) {
+        root = path;
+
         std::shared_ptr<ndnc::posix::FileMetadata> md;
         client->listFile(path, md);
 
@@ -293,37 +428,11 @@ int main(int argc, char *argv[]) {
         }
 
         if (md->isFile()) {
-            metadata.push_back(md);
+            onEntry(md);
+        } else if (recursive) {
+            client->listDirRecursive(path, onEntry);
         } else {
-            std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> partial{};
-
-            if (recursive) {
-                client->listDirRecursive(path, partial);
-            } else {
-                client->listDir(path, partial);
-            }
-
-            metadata.insert(std::end(metadata), std::begin(partial),
-                            std::end(partial));
-        }
-    }
-
-    uint64_t totalByteCount = 0;
-    uint64_t totalFileCount = 0;
-
-    std::cout << "\n";
-    for (auto md : metadata) {
-        if (md->isFile()) {
-            std::cout << ndnc::posix::rdrFileUri(md->getVersionedName(),
-                                                 opts.consumer.prefix)
-                      << "\n";
-            totalByteCount += md->getFileSize();
-            totalFileCount += 1;
-        } else if (list) {
-            std::cout << ndnc::posix::rdrDirUri(md->getVersionedName(),
-                                                opts.consumer.prefix)
-                      << "\n";
-            totalFileCount += 1;
+            client->listDir(path, onEntry);
         }
     }
 
@@ -351,14 +460,17 @@ int main(int argc, char *argv[]) {
 
     std::atomic<uint64_t> currentByteCount = 0;
 
-    auto receiveWorker = [&currentByteCount, &totalByteCount, &bar, &opts,
-                          &metadata](size_t wid) {
-        for (size_t i = wid; i < metadata.size(); i += opts.streams) {
+    // Large files are split in segment ranges across streams and each stream
+    // transfers its ranges largest first
+    auto schedule = ndnc::app::filetransfer::scheduleFileRanges(metadata,
+                                                                opts.streams);
+
+    auto receiveWorker = [&currentByteCount, &totalByteCount, &bar,
+                          &schedule](size_t wid) {
+        for (auto &range : schedule[wid]) {
             client->receiveFileContent(
                 [&](uint64_t bytes) {
-                    auto statistics = consumer->getCounters();
-                    reporter->write(statistics.tx, statistics.rx, bytes,
-                                    statistics.getAverageDelay().count());
+                    reporter->record(bytes);
 
                     if (bar.is_completed()) {
                         return;
@@ -372,20 +484,45 @@ int main(int argc, char *argv[]) {
                     bar.set_progress(currentByteCount);
                     bar.tick();
                 },
-                metadata[i]);
+                range);
         }
     };
 
-    auto requestWorker = [&opts, &metadata](size_t wid) {
-        for (size_t i = wid; i < metadata.size(); i += opts.streams) {
-            client->requestFileContent(metadata[i]);
+    auto requestWorker = [&schedule](size_t wid) {
+        for (auto &range : schedule[wid]) {
+            client->requestFileContent(range);
         }
     };
 
     auto start = std::chrono::high_resolution_clock::now();
 
     for (size_t i = 0; i < metadata.size(); ++i) {
-        client->openFile(metadata[i]);
+        if (metadata[i]->isFile()) {
+            if (!client->openFile(metadata[i], destinations[i])) {
+                LOG_FATAL("unable to open file %s", destinations[i].c_str());
+                programTerminate();
+                return -2;
+            }
+
+            currentByteCount += client->getResumedByteCount(metadata[i]);
+            continue;
+        }
+
+        // Mirror directories, including empty ones
+        std::error_code ec;
+        if (!destinations[i].empty() &&
+            !std::filesystem::create_directories(destinations[i], ec) && ec) {
+            LOG_FATAL("unable to create directory %s",
+                      destinations[i].c_str());
+            programTerminate();
+            return -2;
+        }
+    }
+
+    for (auto &ranges : schedule) {
+        for (auto &range : ranges) {
+            client->openRange(range);
+        }
     }
 
     if (repeat > 0) {
@@ -411,6 +548,12 @@ int main(int argc, char *argv[]) {
     bar.set_option(indicators::option::PrefixText{"Transfer completed "});
     bar.mark_as_completed();
 
+    for (auto &ranges : schedule) {
+        for (auto &range : ranges) {
+            client->closeRange(range);
+        }
+    }
+
     for (size_t i = 0; i < metadata.size(); ++i) {
         if (metadata[i]->isDir()) {
             continue;
@@ -434,7 +577,8 @@ int main(int argc, char *argv[]) {
     std::cout << termcolor::bold << "\n--- statistics ---\n"
               << statistics.tx << " interest packets transmitted, "
               << statistics.rx << " data packets received, "
-              << statistics.timeout << " timeout retries\n"
+              << statistics.timeout << " timeout retries, "
+              << statistics.verifyFailed << " verification failures\n"
               << "average delay: " << statistics.getAverageDelay() << "\n"
               << "goodput: " << binaryPrefix(goodput) << "bit/s"
               << "\n\n";
@@ -0,0 +1,115 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ft-data-cache.hpp"
+
+namespace ndnc::app::filetransfer {
+DataCache::DataCache(size_t capacity) : capacity_{capacity}, bytes_{0} {
+}
+
+bool DataCache::find(const ndn::Name &name, ndn::Block &wire) {
+    if (capacity_ == 0 || name.size() < 2) {
+        return false;
+    }
+
+    auto file = files_.find(name.getPrefix(-2));
+    if (file == files_.end()) {
+        return false;
+    }
+
+    // The file changed since its segments were cached
+    if (file->second.version != name.at(-2).toVersion()) {
+        erase(file);
+        return false;
+    }
+
+    auto segment = file->second.segments.find(name.at(-1).toSegment());
+    if (segment == file->second.segments.end()) {
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, segment->second.second);
+    wire = segment->second.first;
+
+    return true;
+}
+
+void DataCache::insert(const ndn::Name &name, const ndn::Block &wire) {
+    if (wire.size() > capacity_ || name.size() < 2) {
+        return;
+    }
+
+    auto prefix = name.getPrefix(-2);
+    auto version = name.at(-2).toVersion();
+    auto segment = name.at(-1).toSegment();
+
+    auto file = files_.find(prefix);
+    if (file != files_.end() && file->second.version != version) {
+        erase(file);
+        file = files_.end();
+    }
+
+    if (file == files_.end()) {
+        file = files_.emplace(prefix, FileEntry{version, {}}).first;
+    }
+
+    if (file->second.segments.count(segment) > 0) {
+        return;
+    }
+
+    lru_.emplace_front(prefix, segment);
+    file->second.segments.emplace(segment,
+                                  std::make_pair(wire, lru_.begin()));
+    bytes_ += wire.size();
+
+    while (bytes_ > capacity_) {
+        evict();
+    }
+}
+
+void DataCache::erase(FilesMap::iterator file) {
+    for (auto &segment : file->second.segments) {
+        bytes_ -= segment.second.first.size();
+        lru_.erase(segment.second.second);
+    }
+
+    files_.erase(file);
+}
+
+void DataCache::evict() {
+    auto file = files_.find(lru_.back().first);
+    auto segment = file->second.segments.find(lru_.back().second);
+
+    bytes_ -= segment->second.first.size();
+    file->second.segments.erase(segment);
+    lru_.pop_back();
+
+    if (file->second.segments.empty()) {
+        files_.erase(file);
+    }
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,89 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
+
+#include <list>
+#include <unordered_map>
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/name.hpp>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Byte-bounded LRU cache of encoded file content Data packets keyed
+ * by /<prefix>/<path>/<version>/<segment>. Only one version per file is
+ * kept; looking up or inserting a different version evicts the cached one
+ *
+ */
+class DataCache {
+  private:
+    using LruList = std::list<std::pair<ndn::Name, uint64_t>>;
+
+    struct FileEntry {
+        uint64_t version;
+        std::unordered_map<uint64_t, std::pair<ndn::Block, LruList::iterator>>
+            segments;
+    };
+
+    using FilesMap = std::unordered_map<ndn::Name, FileEntry>;
+
+  public:
+    explicit DataCache(size_t capacity);
+
+    /**
+     * @brief Look up an encoded Data packet. The Name must carry the current
+     * version of the file
+     *
+     * @param name The Data packet Name
+     * @param wire The encoded Data packet, on hit
+     * @return true Cache hit
+     * @return false Cache miss
+     */
+    bool find(const ndn::Name &name, ndn::Block &wire);
+
+    void insert(const ndn::Name &name, const ndn::Block &wire);
+
+    size_t getBytesCount() const {
+        return bytes_;
+    }
+
+  private:
+    void erase(FilesMap::iterator file);
+    void evict();
+
+  private:
+    size_t capacity_;
+    size_t bytes_;
+
+    FilesMap files_;
+    LruList lru_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
@@ -0,0 +1,144 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ft-file-cache.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+static uint64_t getVersion(const struct stat &st) {
+    return static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+           st.st_mtim.tv_nsec;
+}
+
+OpenFile::~OpenFile() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool OpenFile::read(uint8_t *buf, size_t len, off_t offset) const {
+    while (len > 0) {
+        auto n = ::pread(fd, buf, len, offset);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            return false;
+        }
+
+        buf += n;
+        len -= n;
+        offset += n;
+    }
+
+    return true;
+}
+
+FileCache::FileCache(size_t capacity)
+    : capacity_{capacity == 0 ? 1 : capacity} {
+}
+
+FileCache::~FileCache() {
+    entries_.clear();
+    lru_.clear();
+}
+
+std::shared_ptr<OpenFile> FileCache::get(const std::string &path) {
+    auto now = std::chrono::steady_clock::now();
+    auto it = entries_.find(path);
+
+    if (it != entries_.end()) {
+        auto &entry = it->second;
+        lru_.splice(lru_.begin(), lru_, entry.lru);
+
+        if (now - entry.checkedAt < std::chrono::seconds(1)) {
+            return entry.file;
+        }
+
+        if (!isModified(path, *entry.file)) {
+            entry.checkedAt = now;
+            return entry.file;
+        }
+
+        lru_.erase(entry.lru);
+        entries_.erase(it);
+    }
+
+    auto file = open(path);
+    if (file == nullptr) {
+        return nullptr;
+    }
+
+    if (entries_.size() >= capacity_) {
+        evict();
+    }
+
+    lru_.push_front(path);
+    entries_[path] = Entry{file, now, lru_.begin()};
+
+    return file;
+}
+
+std::shared_ptr<OpenFile> FileCache::open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        LOG_DEBUG("unable to open file '%s'", path.c_str());
+        return nullptr;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    return std::make_shared<OpenFile>(fd, st.st_ino, getVersion(st),
+                                      st.st_size);
+}
+
+bool FileCache::isModified(const std::string &path, const OpenFile &file) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        return true;
+    }
+
+    return st.st_ino != file.inode || getVersion(st) != file.version ||
+           static_cast<uint64_t>(st.st_size) != file.size;
+}
+
+void FileCache::evict() {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,111 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_FILE_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_FILE_CACHE_HPP
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief A file opened for serving. The descriptor is closed once the last
+ * reference is dropped, so in-flight reads survive cache eviction
+ *
+ */
+struct OpenFile {
+    OpenFile(int fd, uint64_t inode, uint64_t version, uint64_t size)
+        : fd{fd}, inode{inode}, version{version}, size{size} {
+    }
+
+    ~OpenFile();
+
+    /**
+     * @brief Get the last segment number, inclusive
+     *
+     */
+    uint64_t getFinalBlockId(uint64_t segmentSize) const {
+        return size == 0 ? 0 : (size - 1) / segmentSize;
+    }
+
+    /**
+     * @brief Read exactly len bytes at offset
+     *
+     */
+    bool read(uint8_t *buf, size_t len, off_t offset) const;
+
+    int fd;
+    uint64_t inode;
+    // Last modification time in nanoseconds, as used for the RDR version
+    uint64_t version;
+    uint64_t size;
+};
+}; // namespace ndnc::app::filetransfer
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief LRU cache of open file descriptors keyed by path
+ *
+ */
+class FileCache {
+  private:
+    struct Entry {
+        std::shared_ptr<OpenFile> file;
+        std::chrono::steady_clock::time_point checkedAt;
+        std::list<std::string>::iterator lru;
+    };
+
+  public:
+    explicit FileCache(size_t capacity);
+    ~FileCache();
+
+    /**
+     * @brief Get an open regular file. Cached entries are re-validated with
+     * stat at most once per second, so modified or replaced files are
+     * reopened with a new version
+     *
+     * @param path The file path
+     * @return std::shared_ptr<OpenFile> The open file or nullptr on error
+     */
+    std::shared_ptr<OpenFile> get(const std::string &path);
+
+  private:
+    std::shared_ptr<OpenFile> open(const std::string &path);
+    bool isModified(const std::string &path, const OpenFile &file);
+    void evict();
+
+  private:
+    size_t capacity_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_FILE_CACHE_HPP
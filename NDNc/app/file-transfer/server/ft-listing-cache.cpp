@@ -0,0 +1,118 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "ft-listing-cache.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+ListingCache::ListingCache(size_t capacity, size_t segmentSize)
+    : capacity_{capacity == 0 ? 1 : capacity},
+      segmentSize_{segmentSize == 0 ? 1 : segmentSize} {
+}
+
+std::shared_ptr<const DirListing> ListingCache::get(const std::string &path) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return nullptr;
+    }
+
+    auto version = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                   st.st_mtim.tv_nsec;
+
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+
+        if (it->second.listing->version == version) {
+            return it->second.listing;
+        }
+
+        lru_.erase(it->second.lru);
+        entries_.erase(it);
+    }
+
+    auto listing = list(path, version);
+    if (listing == nullptr) {
+        return nullptr;
+    }
+
+    if (entries_.size() >= capacity_) {
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+    }
+
+    lru_.push_front(path);
+    entries_[path] = Entry{listing, lru_.begin()};
+
+    return listing;
+}
+
+std::shared_ptr<const DirListing>
+ListingCache::list(const std::string &path, uint64_t version) {
+    auto dir = ::opendir(path.c_str());
+    if (dir == nullptr) {
+        LOG_DEBUG("unable to open dir '%s'", path.c_str());
+        return nullptr;
+    }
+
+    std::string content;
+    for (auto entry = ::readdir(dir); entry != nullptr;
+         entry = ::readdir(dir)) {
+        if (strcmp(entry->d_name, ".") == 0 ||
+            strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        content.append(entry->d_name);
+        content.push_back('\0');
+    }
+
+    ::closedir(dir);
+
+    auto listing = std::make_shared<DirListing>();
+    listing->version = version;
+
+    // An empty directory still has one, empty, segment
+    size_t offset = 0;
+    do {
+        auto len = std::min(segmentSize_, content.size() - offset);
+        listing->segments.emplace_back(
+            std::make_shared<ndn::Buffer>(content.data() + offset, len));
+        offset += len;
+    } while (offset < content.size());
+
+    LOG_DEBUG("listed dir '%s': %zu segments", path.c_str(),
+              listing->segments.size());
+
+    return listing;
+}
+}; // namespace ndnc::app::filetransfer
@@ -0,0 +1,94 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief A directory listing split into segments. Entry names are NUL
+ * terminated
+ *
+ */
+struct DirListing {
+    // Last modification time in nanoseconds, as used for the RDR version
+    uint64_t version;
+    std::vector<std::shared_ptr<const ndn::Buffer>> segments;
+
+    uint64_t getFinalBlockId() const {
+        return segments.size() - 1;
+    }
+};
+}; // namespace ndnc::app::filetransfer
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief LRU cache of pre-segmented directory listings keyed by path. A
+ * directory is enumerated once per version
+ *
+ */
+class ListingCache {
+  private:
+    struct Entry {
+        std::shared_ptr<const DirListing> listing;
+        std::list<std::string>::iterator lru;
+    };
+
+  public:
+    ListingCache(size_t capacity, size_t segmentSize);
+
+    /**
+     * @brief Get the listing of the current version of a directory
+     *
+     * @param path The directory path
+     * @return std::shared_ptr<const DirListing> The listing or nullptr if
+     * path is not a readable directory
+     */
+    std::shared_ptr<const DirListing> get(const std::string &path);
+
+  private:
+    std::shared_ptr<const DirListing> list(const std::string &path,
+                                           uint64_t version);
+
+  private:
+    size_t capacity_;
+    size_t segmentSize_;
+
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
@@ -0,0 +1,70 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_OPTIONS_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_OPTIONS_HPP
+
+#include <ndn-cxx/name.hpp>
+
+#include "../common/ft-naming-scheme.hpp"
+#include "ft-storage-engine.hpp"
+
+namespace ndnc::app::filetransfer {
+struct ServerOptions {
+    // GraphQL server address
+    std::string gqlserver = "http://localhost:3030/";
+    // Dataroom size
+    size_t mtu = 9000;
+    // Name prefix
+    ndn::Name prefix = ndn::Name(NDNC_NAME_PREFIX_DEFAULT);
+
+    // Segment size
+    size_t segmentSize = 6600;
+
+    // Serve synthetic content instead of reading files
+    bool synthetic = false;
+    // Maximum number of cached open files
+    size_t maxOpenFiles = 1024;
+    // Maximum number of cached directory listings
+    size_t maxCachedListings = 256;
+    // Maximum size in bytes of cached encoded Data packets, per worker
+    size_t dataCacheSize = 64 * 1024 * 1024;
+
+    // Storage engine used for reading file content
+    StorageEngineType storageEngine = StorageEngineType::pread;
+    // io_uring queue depth
+    size_t ioDepth = 128;
+    // pread threads, per worker
+    size_t ioThreads = 4;
+
+    // Worker threads building Data packets. Zero handles Interests inline
+    // on the face-polling thread
+    size_t workers = 0;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_OPTIONS_HPP
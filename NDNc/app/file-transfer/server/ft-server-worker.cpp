@@ -0,0 +1,287 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "codecs/encoding.hpp"
+#include "ft-server-worker.hpp"
+#include "ft-storage-engine-pread.hpp"
+#include "ft-storage-engine-uring.hpp"
+#include "logger/logger.hpp"
+#include "security/digest-sha256.hpp"
+
+namespace ndnc::app::filetransfer {
+ServerWorker::ServerWorker(ServerOptions options, OnPacket onPacket)
+    : options_{options}, onPacket_{onPacket}, files_{options.maxOpenFiles},
+      listings_{options.maxCachedListings, options.segmentSize},
+      data_{options.dataCacheSize}, pendingReads_{0} {
+
+    auto buff = std::make_unique<ndn::Buffer>();
+    buff->assign(options_.segmentSize, 'p');
+    payload_ = ndn::Block(ndn::tlv::Content, std::move(buff));
+
+    if (!options_.synthetic) {
+        openStorageEngine();
+    }
+}
+
+ServerWorker::~ServerWorker() {
+}
+
+void ServerWorker::openStorageEngine() {
+#ifdef NDNC_WITH_IO_URING
+    if (options_.storageEngine == StorageEngineType::io_uring) {
+        auto engine = std::make_unique<StorageEngineUring>(
+            options_.ioDepth, options_.segmentSize);
+        if (engine->isValid()) {
+            storage_ = std::move(engine);
+            return;
+        }
+
+        LOG_WARN("unable to init io_uring; falling back to pread");
+    }
+#else
+    if (options_.storageEngine == StorageEngineType::io_uring) {
+        LOG_WARN("built without io_uring support; falling back to pread");
+    }
+#endif // NDNC_WITH_IO_URING
+
+    storage_ = std::make_unique<StorageEnginePread>(options_.ioThreads);
+}
+
+void ServerWorker::onInterest(std::shared_ptr<ndn::Interest> &&interest,
+                              ndn::lp::PitToken &&pitToken) {
+
+    auto name = interest->getName();
+
+    if (ndnc::posix::isRDRDiscoveryName(name)) {
+        sendData(getFileMetadata(name), std::move(pitToken));
+    } else if (name.size() >= 3 && name.at(-3) == ndnc::posix::lsComponent) {
+        sendData(getDirListingData(name), std::move(pitToken));
+    } else if (options_.synthetic) {
+        sendData(getSyntheticContentData(name), std::move(pitToken));
+    } else {
+        readFileContent(name, std::move(pitToken));
+    }
+}
+
+size_t ServerWorker::poll() {
+    if (storage_ == nullptr || pendingReads_ == 0) {
+        return 0;
+    }
+
+    completed_.clear();
+    auto n = storage_->poll(completed_);
+    pendingReads_ -= n;
+
+    // Sign the segments of this poll together
+    signBatch_.clear();
+    for (auto &request : completed_) {
+        signBatch_.emplace_back(getFileContentData(*request));
+    }
+    ndnc::security::signDigestBatch(signBatch_);
+
+    for (size_t i = 0; i < completed_.size(); ++i) {
+        auto &wire = signBatch_[i]->wireEncode();
+
+        if (completed_[i]->ok) {
+            data_.insert(completed_[i]->name, wire);
+        }
+        sendData(wire, completed_[i]->pitToken);
+    }
+    signBatch_.clear();
+
+    return n;
+}
+
+bool ServerWorker::hasPendingReads() {
+    return pendingReads_ > 0;
+}
+
+ndn::Block ServerWorker::encodeData(std::shared_ptr<ndn::Data> &&data) {
+    return ndnc::security::signDigest(*data);
+}
+
+void ServerWorker::sendData(std::shared_ptr<ndn::Data> &&data,
+                            ndn::lp::PitToken &&pitToken) {
+    sendData(encodeData(std::move(data)), pitToken);
+}
+
+void ServerWorker::sendData(const ndn::Block &wire,
+                            const ndn::lp::PitToken &pitToken) {
+    onPacket_(getWireEncode(wire, pitToken));
+}
+
+std::shared_ptr<ndn::Data>
+ServerWorker::getFileMetadata(const ndn::Name name) {
+    LOG_INFO("received meta Interest %s", name.toUri().c_str());
+
+    auto data = std::make_shared<ndn::Data>(name);
+    ndnc::posix::FileMetadata metadata{options_.segmentSize};
+
+    // Directory listing: /<prefix>/<path>/32=ls/32=metadata
+    auto isListing =
+        name.size() >= 2 && name.at(-2) == ndnc::posix::lsComponent;
+    auto path = isListing ? ndnc::posix::rdrDirUri(name, options_.prefix)
+                          : ndnc::posix::rdrFileUri(name, options_.prefix);
+
+    auto prefix = name.getPrefix(-1);
+    auto ok = metadata.prepare(path, prefix);
+
+    // Directories are always versioned under 32=ls, so either discovery
+    // Name leads to the listing segments
+    if (ok && metadata.isDir() && !isListing) {
+        ok = metadata.prepare(path, prefix.append(ndnc::posix::lsComponent));
+    }
+
+    if (ok && isListing && !metadata.isDir()) {
+        ok = false;
+    }
+
+    if (ok) {
+        data->setContent(metadata.encode());
+        data->setContentType(ndn::tlv::ContentType_Blob);
+    } else {
+        data->setContent(ndn::span<uint8_t>{});
+        data->setContentType(ndn::tlv::ContentType_Nack);
+    }
+
+    data->setFreshnessPeriod(ndn::time::milliseconds{2});
+    return data;
+}
+
+void ServerWorker::readFileContent(const ndn::Name name,
+                                   ndn::lp::PitToken &&pitToken) {
+    // Name: /<prefix>/<path>/<version>/<segment>
+    if (name.size() < options_.prefix.size() + 2 ||
+        !name.at(-1).isSegment() || !name.at(-2).isVersion()) {
+        LOG_DEBUG("invalid content Interest %s", name.toUri().c_str());
+        sendData(getNackData(name), std::move(pitToken));
+        return;
+    }
+
+    auto path = name.getPrefix(-2).getSubName(options_.prefix.size()).toUri();
+    auto file = files_.get(path);
+
+    if (file == nullptr) {
+        sendData(getNackData(name), std::move(pitToken));
+        return;
+    }
+
+    if (file->version != name.at(-2).toVersion()) {
+        LOG_DEBUG("version mismatch for %s", name.toUri().c_str());
+        sendData(getNackData(name), std::move(pitToken));
+        return;
+    }
+
+    // Hot segment; only the PIT token needs to be added
+    ndn::Block wire;
+    if (data_.find(name, wire)) {
+        sendData(wire, pitToken);
+        return;
+    }
+
+    auto segment = name.at(-1).toSegment();
+    auto finalBlockId = file->getFinalBlockId(options_.segmentSize);
+
+    if (segment > finalBlockId) {
+        sendData(getNackData(name), std::move(pitToken));
+        return;
+    }
+
+    // The last segment may be shorter
+    uint64_t offset = segment * options_.segmentSize;
+    uint64_t len =
+        std::min<uint64_t>(options_.segmentSize, file->size - offset);
+
+    // The Data packet is sent from poll() once the read completes
+    ++pendingReads_;
+    storage_->submit(std::make_unique<ReadRequest>(
+        name, std::move(pitToken), file, offset, len, finalBlockId));
+}
+
+std::shared_ptr<ndn::Data>
+ServerWorker::getDirListingData(const ndn::Name name) {
+    // Name: /<prefix>/<path>/32=ls/<version>/<segment>
+    if (name.size() < options_.prefix.size() + 3 ||
+        !name.at(-1).isSegment() || !name.at(-2).isVersion()) {
+        LOG_DEBUG("invalid dir listing Interest %s", name.toUri().c_str());
+        return getNackData(name);
+    }
+
+    auto path = name.getPrefix(-3).getSubName(options_.prefix.size()).toUri();
+    auto listing = listings_.get(path);
+
+    if (listing == nullptr || listing->version != name.at(-2).toVersion()) {
+        return getNackData(name);
+    }
+
+    auto segment = name.at(-1).toSegment();
+    if (segment > listing->getFinalBlockId()) {
+        return getNackData(name);
+    }
+
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setContent(listing->segments[segment]);
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    data->setFinalBlock(
+        ndn::name::Component::fromSegment(listing->getFinalBlockId()));
+    return data;
+}
+
+std::shared_ptr<ndn::Data>
+ServerWorker::getFileContentData(const ReadRequest &request) {
+    if (!request.ok) {
+        LOG_ERROR("unable to read %s", request.name.toUri().c_str());
+        return getNackData(request.name);
+    }
+
+    auto data = std::make_shared<ndn::Data>(request.name);
+    data->setContent(request.buffer);
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    data->setFinalBlock(
+        ndn::name::Component::fromSegment(request.finalBlockId));
+    return data;
+}
+
+std::shared_ptr<ndn::Data>
+ServerWorker::getSyntheticContentData(const ndn::Name name) {
+    auto data = std::make_shared<ndn::Data>(name);
+
+    data->setContent(payload_);
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    return data;
+}
+
+std::shared_ptr<ndn::Data> ServerWorker::getNackData(const ndn::Name name) {
+    auto data = std::make_shared<ndn::Data>(name);
+
+    data->setContent(ndn::span<uint8_t>{});
+    data->setContentType(ndn::tlv::ContentType_Nack);
+    return data;
+}
+}; // namespace ndnc::app::filetransfer
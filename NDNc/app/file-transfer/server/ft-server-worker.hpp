@@ -0,0 +1,108 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_WORKER_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_WORKER_HPP
+
+#include <functional>
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+
+#include "ft-data-cache.hpp"
+#include "ft-file-cache.hpp"
+#include "ft-listing-cache.hpp"
+#include "ft-server-options.hpp"
+#include "ft-storage-engine.hpp"
+#include "lib/posix/file-metadata.hpp"
+#include "lib/posix/file-rdr.hpp"
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Builds Data packets for Interests. A worker is used by one thread
+ * at a time and owns its caches and storage engine
+ *
+ */
+class ServerWorker {
+  public:
+    /**
+     * @brief Invoked with each encoded LpPacket ready to be sent
+     *
+     */
+    using OnPacket = std::function<void(ndn::Block &&pkt)>;
+
+  public:
+    ServerWorker(ServerOptions options, OnPacket onPacket);
+    ~ServerWorker();
+
+    void onInterest(std::shared_ptr<ndn::Interest> &&interest,
+                    ndn::lp::PitToken &&pitToken);
+
+    /**
+     * @brief Send Data packets for completed file reads
+     *
+     * @return size_t The number of Data packets sent
+     */
+    size_t poll();
+
+    /**
+     * @brief Check whether file reads are still in flight
+     *
+     */
+    bool hasPendingReads();
+
+  private:
+    void openStorageEngine();
+    ndn::Block encodeData(std::shared_ptr<ndn::Data> &&data);
+    void sendData(std::shared_ptr<ndn::Data> &&data,
+                  ndn::lp::PitToken &&pitToken);
+    void sendData(const ndn::Block &wire, const ndn::lp::PitToken &pitToken);
+    void readFileContent(const ndn::Name name, ndn::lp::PitToken &&pitToken);
+    std::shared_ptr<ndn::Data> getDirListingData(const ndn::Name name);
+
+    std::shared_ptr<ndn::Data> getFileMetadata(const ndn::Name name);
+    std::shared_ptr<ndn::Data> getFileContentData(const ReadRequest &request);
+    std::shared_ptr<ndn::Data> getSyntheticContentData(const ndn::Name name);
+    std::shared_ptr<ndn::Data> getNackData(const ndn::Name name);
+
+  private:
+    ServerOptions options_;
+    OnPacket onPacket_;
+
+    FileCache files_;
+    ListingCache listings_;
+    DataCache data_;
+    std::unique_ptr<StorageEngine> storage_;
+    std::vector<std::unique_ptr<ReadRequest>> completed_;
+    std::vector<std::shared_ptr<ndn::Data>> signBatch_;
+    size_t pendingReads_;
+
+    ndn::Block payload_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_WORKER_HPP
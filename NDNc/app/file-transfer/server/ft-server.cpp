@@ -25,66 +25,141 @@
  * SOFTWARE.
  */
 
-#include <math.h>
-
 #include "ft-server.hpp"
 #include "logger/logger.hpp"
 
 namespace ndnc::app::filetransfer {
 Server::Server(face::Face &face, ServerOptions options)
-    : PacketHandler(face), options_{options}, signatureInfo_{} {
+    : PacketHandler(face), options_{options}, stop_{false} {
+
+    if (options_.workers == 0) {
+        workers_.emplace_back(std::make_unique<ServerWorker>(
+            options_, [this](ndn::Block &&pkt) {
+                // Queued on the face and sent with the rest of the burst
+                if (this->face != nullptr && this->face->send(pkt) < 0) {
+                    LOG_WARN("unable to send Data packet");
+                }
+            }));
+        return;
+    }
 
-    auto buff = std::make_unique<ndn::Buffer>();
-    buff->assign(options_.segmentSize, 'p');
-    payload_ = ndn::Block(ndn::tlv::Content, std::move(buff));
+    for (size_t i = 0; i < options_.workers; ++i) {
+        workers_.emplace_back(std::make_unique<ServerWorker>(
+            options_,
+            [this](ndn::Block &&pkt) { this->tx_.enqueue(std::move(pkt)); }));
+        queues_.emplace_back(std::make_unique<InterestQueue>());
+    }
 
-    signatureInfo_.setSignatureType(ndn::tlv::DigestSha256);
+    for (size_t i = 0; i < options_.workers; ++i) {
+        threads_.push_back(std::thread(&Server::run, this, i));
+    }
 }
 
 Server::~Server() {
+    stop_ = true;
+
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
 }
 
 void Server::onInterest(std::shared_ptr<ndn::Interest> &&interest,
                         ndn::lp::PitToken &&pitToken) {
+    if (queues_.empty()) {
+        workers_.front()->onInterest(std::move(interest), std::move(pitToken));
+        return;
+    }
 
-    auto name = interest->getName();
-    auto data = ndnc::posix::isRDRDiscoveryName(name)
-                    ? getFileMetadata(name)
-                    : getFileContentData(name);
+    auto id = getWorkerId(interest->getName());
+    queues_[id]->enqueue(std::make_unique<IncomingInterest>(
+        std::move(interest), std::move(pitToken)));
+}
 
-    data->setSignatureInfo(signatureInfo_);
-    data->setSignatureValue(std::make_shared<ndn::Buffer>());
+void Server::poll() {
+    if (queues_.empty()) {
+        // Send the Data packets of the reads completed in this poll
+        if (workers_.front()->poll() > 0 && face != nullptr) {
+            face->flush();
+        }
+        return;
+    }
 
-    if (face != nullptr &&
-        !face->send(getWireEncode(std::move(data), std::move(pitToken)))) {
-        LOG_WARN("unable to send Data packet");
+    if (face == nullptr) {
+        size_t n = 0;
+        txBurst_.resize(MAX_MEMIF_TX_BUFS);
+        while ((n = tx_.try_dequeue_bulk(txBurst_.begin(),
+                                         MAX_MEMIF_TX_BUFS)) > 0) {
+            LOG_WARN("unable to send %zu Data packets", n);
+        }
+        txBurst_.clear();
+        return;
     }
+
+    while (true) {
+        // The Data packets the face had no room for on the previous poll go
+        // first
+        if (txBurst_.empty()) {
+            txBurst_.resize(MAX_MEMIF_TX_BUFS);
+            txBurst_.resize(
+                tx_.try_dequeue_bulk(txBurst_.begin(), MAX_MEMIF_TX_BUFS));
+
+            if (txBurst_.empty()) {
+                break;
+            }
+        }
+
+        // The face keeps the packets the transport does not accept and
+        // retries them on the next flush
+        size_t sent = 0;
+        while (sent < txBurst_.size() && face->send(txBurst_[sent]) > 0) {
+            ++sent;
+        }
+        txBurst_.erase(txBurst_.begin(), txBurst_.begin() + sent);
+
+        if (!txBurst_.empty()) {
+            LOG_DEBUG("%zu Data packets wait for the transport",
+                      txBurst_.size());
+            break;
+        }
+    }
+
+    face->flush();
 }
 
-std::shared_ptr<ndn::Data> Server::getFileMetadata(const ndn::Name name) {
-    LOG_INFO("received meta Interest %s", name.toUri().c_str());
+void Server::run(size_t id) {
+    auto &worker = *workers_[id];
+    auto &queue = *queues_[id];
 
-    auto data = std::make_shared<ndn::Data>(name);
-    ndnc::posix::FileMetadata metadata{options_.segmentSize};
+    std::unique_ptr<IncomingInterest> interests[64];
 
-    if (metadata.prepare(ndnc::posix::rdrFileUri(name, options_.prefix),
-                         name.getPrefix(-1))) {
-        data->setContent(metadata.encode());
-        data->setContentType(ndn::tlv::ContentType_Blob);
-    } else {
-        data->setContent(ndn::span<uint8_t>{});
-        data->setContentType(ndn::tlv::ContentType_Nack);
-    }
+    while (!stop_) {
+        size_t n = 0;
 
-    data->setFreshnessPeriod(ndn::time::milliseconds{2});
-    return data;
-}
+        // Block only when no file reads need to be reaped
+        if (worker.hasPendingReads()) {
+            n = queue.try_dequeue_bulk(interests, 64);
+        } else {
+            n = queue.wait_dequeue_bulk_timed(interests, 64,
+                                              std::chrono::milliseconds(10));
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            worker.onInterest(std::move(interests[i]->interest),
+                              std::move(interests[i]->pitToken));
+            interests[i].reset();
+        }
 
-std::shared_ptr<ndn::Data> Server::getFileContentData(const ndn::Name name) {
-    auto data = std::make_shared<ndn::Data>(name);
+        worker.poll();
+    }
+}
 
-    data->setContent(payload_);
-    data->setContentType(ndn::tlv::ContentType_Blob);
-    return data;
+size_t Server::getWorkerId(const ndn::Name &name) {
+    // Shard by the Name without its segment number, so all segments of a
+    // file are served by the same worker and its caches
+    auto prefix =
+        !name.empty() && name.at(-1).isSegment() ? name.getPrefix(-1) : name;
+    return std::hash<ndn::Name>{}(prefix) % workers_.size();
 }
 }; // namespace ndnc::app::filetransfer
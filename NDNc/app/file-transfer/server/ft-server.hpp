@@ -28,43 +28,67 @@
 #ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_HPP
 #define NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_HPP
 
-#include "../common/ft-naming-scheme.hpp"
+#include <atomic>
+#include <thread>
+
+#include "congestion-control/concurrentqueue/blockingconcurrentqueue.h"
+#include "congestion-control/concurrentqueue/concurrentqueue.h"
 #include "face/packet-handler.hpp"
-#include "lib/posix/file-metadata.hpp"
-#include "lib/posix/file-rdr.hpp"
+#include "ft-server-options.hpp"
+#include "ft-server-worker.hpp"
 
 namespace ndnc::app::filetransfer {
-struct ServerOptions {
-    // GraphQL server address
-    std::string gqlserver = "http://localhost:3030/";
-    // Dataroom size
-    size_t mtu = 9000;
-    // Name prefix
-    ndn::Name prefix = ndn::Name(NDNC_NAME_PREFIX_DEFAULT);
+class Server : public PacketHandler {
+  private:
+    struct IncomingInterest {
+        IncomingInterest(std::shared_ptr<ndn::Interest> &&interest,
+                         ndn::lp::PitToken &&pitToken)
+            : interest{std::move(interest)}, pitToken{std::move(pitToken)} {
+        }
 
-    // Segment size
-    size_t segmentSize = 6600;
-};
-}; // namespace ndnc::app::filetransfer
+        std::shared_ptr<ndn::Interest> interest;
+        ndn::lp::PitToken pitToken;
+    };
+
+    using InterestQueue =
+        moodycamel::BlockingConcurrentQueue<std::unique_ptr<IncomingInterest>>;
 
-namespace ndnc::app::filetransfer {
-class Server : public PacketHandler {
   public:
     explicit Server(face::Face &face, ServerOptions options);
     ~Server();
 
   public:
+    /**
+     * @brief Handle an Interest inline or hand it to the worker owning its
+     * Name prefix
+     *
+     */
     void onInterest(std::shared_ptr<ndn::Interest> &&interest,
                     ndn::lp::PitToken &&pitToken) final;
 
+    /**
+     * @brief Send the Data packets produced by the workers in bursts. Call
+     * from the face-polling loop, which remains the only thread using the
+     * face
+     *
+     */
+    void poll();
+
   private:
-    std::shared_ptr<ndn::Data> getFileMetadata(const ndn::Name name);
-    std::shared_ptr<ndn::Data> getFileContentData(const ndn::Name name);
+    void run(size_t id);
+    size_t getWorkerId(const ndn::Name &name);
 
   private:
     ServerOptions options_;
-    ndn::Block payload_;
-    ndn::SignatureInfo signatureInfo_;
+
+    std::vector<std::unique_ptr<ServerWorker>> workers_;
+    std::vector<std::unique_ptr<InterestQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic_bool stop_;
+
+    moodycamel::ConcurrentQueue<ndn::Block> tx_;
+    // Data packets dequeued from tx_ that the face had no room for yet
+    std::vector<ndn::Block> txBurst_;
 };
 }; // namespace ndnc::app::filetransfer
 
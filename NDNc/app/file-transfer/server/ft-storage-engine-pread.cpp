@@ -0,0 +1,81 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "ft-storage-engine-pread.hpp"
+
+namespace ndnc::app::filetransfer {
+StorageEnginePread::StorageEnginePread(size_t threads) : stop_{false} {
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+        workers_.push_back(std::thread(&StorageEnginePread::run, this));
+    }
+}
+
+StorageEnginePread::~StorageEnginePread() {
+    stop_ = true;
+
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void StorageEnginePread::submit(std::unique_ptr<ReadRequest> &&request) {
+    pending_.enqueue(std::move(request));
+}
+
+size_t
+StorageEnginePread::poll(std::vector<std::unique_ptr<ReadRequest>> &completed) {
+    std::unique_ptr<ReadRequest> requests[64];
+
+    auto n = completed_.try_dequeue_bulk(requests, 64);
+    for (size_t i = 0; i < n; ++i) {
+        completed.emplace_back(std::move(requests[i]));
+    }
+
+    return n;
+}
+
+void StorageEnginePread::run() {
+    std::unique_ptr<ReadRequest> request;
+
+    while (!stop_) {
+        if (!pending_.wait_dequeue_timed(request,
+                                         std::chrono::milliseconds(100))) {
+            continue;
+        }
+
+        request->buffer = std::make_shared<ndn::Buffer>(request->len);
+        request->ok = request->file->read(request->buffer->data(),
+                                          request->len, request->offset);
+
+        completed_.enqueue(std::move(request));
+    }
+}
+}; // namespace ndnc::app::filetransfer
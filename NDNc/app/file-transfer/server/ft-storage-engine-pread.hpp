@@ -0,0 +1,64 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_PREAD_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_PREAD_HPP
+
+#include <atomic>
+#include <thread>
+
+#include "congestion-control/concurrentqueue/blockingconcurrentqueue.h"
+#include "congestion-control/concurrentqueue/concurrentqueue.h"
+#include "ft-storage-engine.hpp"
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Blocking pread calls on a pool of worker threads
+ *
+ */
+class StorageEnginePread : public StorageEngine {
+  public:
+    explicit StorageEnginePread(size_t threads);
+    ~StorageEnginePread();
+
+    void submit(std::unique_ptr<ReadRequest> &&request) final;
+    size_t poll(std::vector<std::unique_ptr<ReadRequest>> &completed) final;
+
+  private:
+    void run();
+
+  private:
+    moodycamel::BlockingConcurrentQueue<std::unique_ptr<ReadRequest>>
+        pending_;
+    moodycamel::ConcurrentQueue<std::unique_ptr<ReadRequest>> completed_;
+
+    std::vector<std::thread> workers_;
+    std::atomic_bool stop_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_PREAD_HPP
@@ -0,0 +1,242 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef NDNC_WITH_IO_URING
+
+#include <algorithm>
+#include <cstring>
+#include <sys/uio.h>
+
+#include "ft-storage-engine-uring.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+StorageEngineUring::StorageEngineUring(size_t depth, size_t bufferSize)
+    : valid_{false}, fixed_{false}, buffers_{nullptr}, queued_{0} {
+    depth = std::max<size_t>(depth, 1);
+
+    // Keep each slot page aligned
+    bufferSize_ = (bufferSize + 4095) & ~static_cast<size_t>(4095);
+
+    int res = io_uring_queue_init(depth, &ring_, 0);
+    if (res < 0) {
+        LOG_ERROR("io_uring_queue_init: %s", strerror(-res));
+        return;
+    }
+
+    buffers_ = static_cast<uint8_t *>(aligned_alloc(4096, depth * bufferSize_));
+    if (buffers_ == nullptr) {
+        LOG_ERROR("unable to allocate io_uring buffers");
+        io_uring_queue_exit(&ring_);
+        return;
+    }
+
+    std::vector<struct iovec> iovecs(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        iovecs[i].iov_base = buffers_ + i * bufferSize_;
+        iovecs[i].iov_len = bufferSize_;
+    }
+
+    // Registration may fail under a low RLIMIT_MEMLOCK; plain reads into the
+    // same buffers still work
+    res = io_uring_register_buffers(&ring_, iovecs.data(), depth);
+    fixed_ = res == 0;
+    if (!fixed_) {
+        LOG_WARN("io_uring_register_buffers: %s", strerror(-res));
+    }
+
+    slots_.resize(depth);
+    for (size_t i = depth; i > 0; --i) {
+        freeSlots_.push_back(i - 1);
+    }
+
+    valid_ = true;
+}
+
+StorageEngineUring::~StorageEngineUring() {
+    if (!valid_) {
+        return;
+    }
+
+    // Wait for in-flight reads before releasing their buffers
+    io_uring_submit(&ring_);
+    for (size_t inflight = slots_.size() - freeSlots_.size(); inflight > 0;
+         --inflight) {
+        struct io_uring_cqe *cqe;
+        if (io_uring_wait_cqe(&ring_, &cqe) != 0) {
+            break;
+        }
+        io_uring_cqe_seen(&ring_, cqe);
+    }
+
+    if (fixed_) {
+        io_uring_unregister_buffers(&ring_);
+    }
+
+    io_uring_queue_exit(&ring_);
+    free(buffers_);
+}
+
+bool StorageEngineUring::isValid() {
+    return valid_;
+}
+
+void StorageEngineUring::submit(std::unique_ptr<ReadRequest> &&request) {
+    // Nothing to read, e.g. the only segment of an empty file
+    if (request->len == 0) {
+        request->buffer = std::make_shared<ndn::Buffer>();
+        request->ok = true;
+        ready_.emplace_back(std::move(request));
+        return;
+    }
+
+    backlog_.emplace_back(std::move(request));
+}
+
+size_t
+StorageEngineUring::poll(std::vector<std::unique_ptr<ReadRequest>> &completed) {
+    auto n = completed.size();
+
+    for (auto &request : ready_) {
+        completed.emplace_back(std::move(request));
+    }
+    ready_.clear();
+
+    dispatch(completed);
+
+    if (queued_ > 0) {
+        int res = io_uring_submit(&ring_);
+        if (res > 0) {
+            queued_ -= std::min<unsigned>(queued_, res);
+        }
+    }
+
+    struct io_uring_cqe *cqes[64];
+    auto ncqes = io_uring_peek_batch_cqe(&ring_, cqes, 64);
+
+    for (unsigned i = 0; i < ncqes; ++i) {
+        auto slot = reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(cqes[i]));
+        auto res = cqes[i]->res;
+
+        if (res == -EAGAIN || res == -EINTR) {
+            if (!prepare(slot)) {
+                complete(slot, false, completed);
+            }
+            continue;
+        }
+
+        // End of file before the whole segment was read
+        if (res < 0 ||
+            (res == 0 && slots_[slot].done < slots_[slot].request->len)) {
+            complete(slot, false, completed);
+            continue;
+        }
+
+        slots_[slot].done += res;
+
+        // Short read; queue the remaining bytes
+        if (slots_[slot].done < slots_[slot].request->len) {
+            if (!prepare(slot)) {
+                complete(slot, false, completed);
+            }
+            continue;
+        }
+
+        complete(slot, true, completed);
+    }
+
+    io_uring_cq_advance(&ring_, ncqes);
+
+    return completed.size() - n;
+}
+
+void StorageEngineUring::dispatch(
+    std::vector<std::unique_ptr<ReadRequest>> &completed) {
+    while (!backlog_.empty() && !freeSlots_.empty()) {
+        auto slot = freeSlots_.back();
+        freeSlots_.pop_back();
+
+        slots_[slot].request = std::move(backlog_.front());
+        slots_[slot].done = 0;
+        backlog_.pop_front();
+
+        if (slots_[slot].request->len > bufferSize_) {
+            complete(slot, false, completed);
+            continue;
+        }
+
+        if (!prepare(slot)) {
+            // Submission queue is full; retry on the next poll
+            backlog_.emplace_front(std::move(slots_[slot].request));
+            freeSlots_.push_back(slot);
+            break;
+        }
+    }
+}
+
+bool StorageEngineUring::prepare(size_t slot) {
+    auto sqe = io_uring_get_sqe(&ring_);
+    if (sqe == nullptr) {
+        return false;
+    }
+
+    auto &request = *slots_[slot].request;
+    auto done = slots_[slot].done;
+    auto buf = buffers_ + slot * bufferSize_ + done;
+
+    if (fixed_) {
+        io_uring_prep_read_fixed(sqe, request.file->fd, buf, request.len - done,
+                                 request.offset + done, slot);
+    } else {
+        io_uring_prep_read(sqe, request.file->fd, buf, request.len - done,
+                           request.offset + done);
+    }
+
+    io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(slot));
+    ++queued_;
+
+    return true;
+}
+
+void StorageEngineUring::complete(
+    size_t slot, bool ok,
+    std::vector<std::unique_ptr<ReadRequest>> &completed) {
+    auto request = std::move(slots_[slot].request);
+
+    if (ok) {
+        request->buffer = std::make_shared<ndn::Buffer>(
+            buffers_ + slot * bufferSize_, request->len);
+    }
+
+    request->ok = ok;
+    completed.emplace_back(std::move(request));
+
+    freeSlots_.push_back(slot);
+}
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_WITH_IO_URING
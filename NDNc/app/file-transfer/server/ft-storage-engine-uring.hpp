@@ -0,0 +1,88 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_URING_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_URING_HPP
+
+#ifdef NDNC_WITH_IO_URING
+
+#include <deque>
+
+#include <liburing.h>
+
+#include "ft-storage-engine.hpp"
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief Batched reads through io_uring into registered buffers. Each of the
+ * depth in-flight reads owns one segment-sized buffer slot
+ *
+ */
+class StorageEngineUring : public StorageEngine {
+  private:
+    struct Slot {
+        std::unique_ptr<ReadRequest> request = nullptr;
+        size_t done = 0;
+    };
+
+  public:
+    StorageEngineUring(size_t depth, size_t bufferSize);
+    ~StorageEngineUring();
+
+    bool isValid();
+
+    void submit(std::unique_ptr<ReadRequest> &&request) final;
+    size_t poll(std::vector<std::unique_ptr<ReadRequest>> &completed) final;
+
+  private:
+    void dispatch(std::vector<std::unique_ptr<ReadRequest>> &completed);
+    bool prepare(size_t slot);
+    void complete(size_t slot, bool ok,
+                  std::vector<std::unique_ptr<ReadRequest>> &completed);
+
+  private:
+    struct io_uring ring_;
+    bool valid_;
+    bool fixed_;
+
+    uint8_t *buffers_;
+    size_t bufferSize_;
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> freeSlots_;
+    std::deque<std::unique_ptr<ReadRequest>> backlog_;
+    // Requests completed without a read, e.g. of empty files
+    std::vector<std::unique_ptr<ReadRequest>> ready_;
+
+    // Prepared SQEs not yet submitted to the kernel
+    unsigned queued_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_WITH_IO_URING
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_URING_HPP
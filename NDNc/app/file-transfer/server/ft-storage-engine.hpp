@@ -0,0 +1,97 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_HPP
+
+#include <memory>
+#include <vector>
+
+#include <ndn-cxx/encoding/buffer.hpp>
+#include <ndn-cxx/lp/pit-token.hpp>
+#include <ndn-cxx/name.hpp>
+
+#include "ft-file-cache.hpp"
+
+namespace ndnc::app::filetransfer {
+enum class StorageEngineType
+{
+    pread = 0,
+    io_uring = 1
+};
+
+/**
+ * @brief A segment read on behalf of a pending Interest
+ *
+ */
+struct ReadRequest {
+    ReadRequest(const ndn::Name &name, ndn::lp::PitToken &&pitToken,
+                std::shared_ptr<OpenFile> file, uint64_t offset, size_t len,
+                uint64_t finalBlockId)
+        : name{name}, pitToken{std::move(pitToken)}, file{file},
+          offset{offset}, len{len}, finalBlockId{finalBlockId} {
+    }
+
+    ndn::Name name;
+    ndn::lp::PitToken pitToken;
+
+    std::shared_ptr<OpenFile> file;
+    uint64_t offset;
+    size_t len;
+    uint64_t finalBlockId;
+
+    // Set by the storage engine on completion
+    std::shared_ptr<ndn::Buffer> buffer = nullptr;
+    bool ok = false;
+};
+
+/**
+ * @brief Asynchronous segment reads. submit and poll are called from the
+ * face-polling thread and never block
+ *
+ */
+class StorageEngine {
+  public:
+    virtual ~StorageEngine() = default;
+
+    /**
+     * @brief Queue a read request
+     *
+     */
+    virtual void submit(std::unique_ptr<ReadRequest> &&request) = 0;
+
+    /**
+     * @brief Move completed read requests to completed
+     *
+     * @return size_t The number of completed read requests
+     */
+    virtual size_t
+    poll(std::vector<std::unique_ptr<ReadRequest>> &completed) = 0;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_STORAGE_ENGINE_HPP
@@ -58,6 +58,8 @@ int main(int argc, char **argv) {
 
     ndnc::app::filetransfer::ServerOptions opts;
     std::string prefix = ndnc::app::filetransfer::NDNC_NAME_PREFIX_DEFAULT;
+    std::string storageEngine = "pread";
+    size_t dataCacheSize = opts.dataCacheSize / (1024 * 1024);
 
     po::options_description description("Options", 120);
     description.add_options()(
@@ -79,6 +81,41 @@ int main(int argc, char **argv) {
                "equal to " +
                to_string(ndn::MAX_NDN_PACKET_SIZE))
             .c_str());
+    description.add_options()(
+        "max-open-files",
+        po::value<size_t>(&opts.maxOpenFiles)->default_value(opts.maxOpenFiles),
+        "The maximum number of files kept open for serving content. Specify a "
+        "positive integer");
+    description.add_options()(
+        "data-cache-size",
+        po::value<size_t>(&dataCacheSize)->default_value(dataCacheSize),
+        "The size in MiB of the encoded Data packets cache of each worker. "
+        "Specify 0 to disable caching");
+    description.add_options()(
+        "storage-engine",
+        po::value<string>(&storageEngine)->default_value(storageEngine),
+        "The storage engine used for reading file content. Available options: "
+        "pread, io_uring");
+    description.add_options()(
+        "io-depth",
+        po::value<size_t>(&opts.ioDepth)->default_value(opts.ioDepth),
+        "The io_uring queue depth. Specify a positive integer between 1 and "
+        "4096");
+    description.add_options()(
+        "io-threads",
+        po::value<size_t>(&opts.ioThreads)->default_value(opts.ioThreads),
+        "The number of pread worker threads. Specify a positive integer "
+        "between 1 and 64");
+    description.add_options()(
+        "workers",
+        po::value<size_t>(&opts.workers)->default_value(opts.workers),
+        "The number of worker threads building Data packets. Interests are "
+        "sharded by Name. Specify 0 to handle Interests on the face thread, "
+        "or a positive integer up to 64");
+    description.add_options()(
+        "synthetic", po::bool_switch(&opts.synthetic),
+        "Serve synthetic content instead of reading files. Useful for "
+        "measuring network throughput");
     description.add_options()("help,h", "Print this help message and exit");
 
     po::variables_map vm;
@@ -123,6 +160,54 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (vm.count("max-open-files") > 0) {
+        if (opts.maxOpenFiles == 0) {
+            cerr << "ERROR: invalid max open files value\n\n";
+            usage(cout, description);
+            return 2;
+        }
+    }
+
+    opts.dataCacheSize = dataCacheSize * 1024 * 1024;
+
+    if (vm.count("storage-engine") > 0) {
+        if (storageEngine.compare("pread") == 0) {
+            opts.storageEngine =
+                ndnc::app::filetransfer::StorageEngineType::pread;
+        } else if (storageEngine.compare("io_uring") == 0) {
+            opts.storageEngine =
+                ndnc::app::filetransfer::StorageEngineType::io_uring;
+        } else {
+            cerr << "ERROR: invalid storage engine value\n\n";
+            usage(cout, description);
+            return 2;
+        }
+    }
+
+    if (vm.count("io-depth") > 0) {
+        if (opts.ioDepth < 1 || opts.ioDepth > 4096) {
+            cerr << "ERROR: invalid io depth value\n\n";
+            usage(cout, description);
+            return 2;
+        }
+    }
+
+    if (vm.count("io-threads") > 0) {
+        if (opts.ioThreads < 1 || opts.ioThreads > 64) {
+            cerr << "ERROR: invalid io threads value\n\n";
+            usage(cout, description);
+            return 2;
+        }
+    }
+
+    if (vm.count("workers") > 0) {
+        if (opts.workers > 64) {
+            cerr << "ERROR: invalid workers value\n\n";
+            usage(cout, description);
+            return 2;
+        }
+    }
+
     if (vm.count("name-prefix") > 0) {
         if (opts.prefix.empty()) {
             cerr << "ERROR: empty name prefix value\n\n";
@@ -149,6 +234,7 @@ int main(int argc, char **argv) {
 
     while (shouldRun && face->isConnected()) {
         face->loop();
+        server->poll();
     }
 
     cout << endl;
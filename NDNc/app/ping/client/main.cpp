@@ -26,6 +26,7 @@
  */
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 
 #include <boost/program_options/options_description.hpp>
@@ -63,6 +64,14 @@ int main(int argc, char *argv[]) {
 
     ndnc::ping::ClientOptions opts;
     po::options_description description("Options", 120);
+    description.add_options()(
+        "concurrency",
+        po::value<size_t>(&opts.concurrency)->default_value(opts.concurrency),
+        "The maximum number of Interests in flight. Without --rate, this many "
+        "Interests are kept outstanding (closed-loop)");
+    description.add_options()(
+        "count", po::value<uint64_t>(&opts.count)->default_value(opts.count),
+        "The number of Interests to send. Specify 0 to run until interrupted");
     description.add_options()(
         "gqlserver",
         po::value<string>(&opts.gqlserver)->default_value(opts.gqlserver),
@@ -77,6 +86,10 @@ int main(int argc, char *argv[]) {
     description.add_options()(
         "name", po::value<string>(&opts.name),
         "The NDN Name prefix of all expressed Interest packets");
+    description.add_options()(
+        "rate", po::value<double>(&opts.rate)->default_value(opts.rate),
+        "Send Interests at this many packets per second regardless of "
+        "responses (open-loop). Specify 0 for closed-loop");
     description.add_options()("help,h", "Print this help message and exit");
 
     po::variables_map vm;
@@ -132,6 +145,18 @@ int main(int argc, char *argv[]) {
         return 2;
     }
 
+    if (opts.concurrency == 0) {
+        cerr << "ERROR: concurrency must be a positive integer\n\n";
+        usage(cout, app, description);
+        return 2;
+    }
+
+    if (opts.rate < 0) {
+        cerr << "ERROR: negative rate argument value\n\n";
+        usage(cout, app, description);
+        return 2;
+    }
+
     auto face = new ndnc::face::Face();
     if (!face->connect(opts.mtu, opts.gqlserver, "ndncping-client")) {
         return 2;
@@ -145,14 +170,33 @@ int main(int argc, char *argv[]) {
         client->run();
     }
 
-    auto lossRation = (1.0 - ((double)client->getCounters().nRxData /
-                              (double)client->getCounters().nTxInterests)) *
-                      100;
+    auto counters = client->getCounters();
+    auto lossRation = counters.nTxInterests == 0
+                          ? 0.0
+                          : (1.0 - ((double)counters.nRxData /
+                                    (double)counters.nTxInterests)) *
+                                100;
+
+    auto &rtt = client->getRttHistogram();
+    auto elapsed = chrono::duration<double>(client->getElapsed()).count();
+    auto toMicroseconds = [](uint64_t nanoseconds) {
+        return (double)nanoseconds / 1000;
+    };
 
     cout << "\n--- statistics --\n"
-         << client->getCounters().nTxInterests << " packets transmitted, "
-         << client->getCounters().nRxData << " packets received, " << lossRation
-         << "% packet loss\n\n";
+         << counters.nTxInterests << " packets transmitted, "
+         << counters.nRxData << " packets received, " << lossRation
+         << "% packet loss, " << counters.nErrors << " errors\n"
+         << fixed << setprecision(2) << "rtt (us) min/avg/p50/p99/p99.9/max = "
+         << toMicroseconds(rtt.getMin()) << "/"
+         << toMicroseconds((uint64_t)rtt.getMean()) << "/"
+         << toMicroseconds(rtt.getValueAtPercentile(50)) << "/"
+         << toMicroseconds(rtt.getValueAtPercentile(99)) << "/"
+         << toMicroseconds(rtt.getValueAtPercentile(99.9)) << "/"
+         << toMicroseconds(rtt.getMax()) << "\n"
+         << "throughput = "
+         << (elapsed > 0 ? (double)counters.nRxData / elapsed : 0)
+         << " pps in " << elapsed << " s\n\n";
 
     if (client != nullptr) {
         delete client;
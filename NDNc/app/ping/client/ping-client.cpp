@@ -25,6 +25,7 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include <random>
 
 #include <boost/lexical_cast.hpp>
@@ -45,7 +46,12 @@ Client::Client(face::Face &face, ClientOptions options)
     std::uniform_int_distribution<uint64_t> dist;
     m_sequence = dist(gen);
 
-    m_pipeline = std::make_shared<PipelineInterestsFixed>(face, 1);
+    m_options.concurrency = std::max<size_t>(m_options.concurrency, 1);
+    m_pipeline = std::make_shared<PipelineInterestsFixed>(
+        face, m_options.concurrency);
+
+    m_received.resize(64);
+    m_start = m_end = m_lastExpire = Clock::now();
 }
 
 Client::~Client() {
@@ -53,6 +59,10 @@ Client::~Client() {
 }
 
 void Client::stop() {
+    if (!m_stop) {
+        m_end = Clock::now();
+    }
+
     m_stop = true;
     m_pipeline->close();
 }
@@ -62,37 +72,179 @@ bool Client::canContinue() {
 }
 
 void Client::run() {
-    auto interest = std::make_shared<ndn::Interest>(
-        ndn::Name(m_options.name).appendSequenceNumber(++m_sequence));
-    interest->setMustBeFresh(true);
-    interest->setInterestLifetime(m_options.lifetime);
+    if (m_options.rate > 0) {
+        sendOpenLoop();
+    } else {
+        sendClosedLoop();
+    }
+
+    receive();
 
-    if (!m_pipeline->pushInterest(0, std::move(interest))) {
+    auto now = Clock::now();
+    if (now - m_lastExpire > std::chrono::seconds{1}) {
+        expire(now);
+    }
+
+    if (m_options.count > 0 && m_counters.nTxInterests >= m_options.count &&
+        m_outstanding.empty()) {
+        m_end = now;
         m_stop = true;
-        LOG_WARN("unable to push Interest packet");
+    }
+}
+
+bool Client::isLoadMode() const {
+    return m_options.concurrency > 1 || m_options.rate > 0;
+}
+
+void Client::sendClosedLoop() {
+    if (m_outstanding.size() >= m_options.concurrency) {
+        return;
+    }
+
+    size_t n = m_options.concurrency - m_outstanding.size();
+    if (m_options.count > 0) {
+        n = std::min<uint64_t>(n, m_options.count - m_counters.nTxInterests);
+    }
+
+    if (n > 0) {
+        send(n, Clock::now());
+    }
+}
+
+void Client::sendOpenLoop() {
+    auto elapsed = std::chrono::duration<double>(Clock::now() - m_start);
+    auto due = static_cast<uint64_t>(elapsed.count() * m_options.rate) + 1;
+
+    if (m_options.count > 0) {
+        due = std::min(due, m_options.count);
+    }
+
+    if (due <= m_counters.nTxInterests) {
         return;
     }
 
-    ++m_counters.nTxInterests;
-    auto start = ndn::time::system_clock::now();
+    // Schedule from the intended send time of the first Interest so a slow
+    // response does not hide the delay of the ones queued behind it
+    auto scheduled =
+        m_start + std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double>(m_counters.nTxInterests /
+                                                    m_options.rate));
+
+    send(std::min<uint64_t>(due - m_counters.nTxInterests, 64), scheduled);
+}
+
+bool Client::send(size_t n, Clock::time_point scheduled) {
+    auto interval = m_options.rate > 0
+                        ? std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(1 / m_options.rate))
+                        : Clock::duration::zero();
+
+    std::vector<std::shared_ptr<ndn::Interest>> pkts;
+    pkts.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        auto interest = std::make_shared<ndn::Interest>(
+            ndn::Name(m_options.name).appendSequenceNumber(++m_sequence));
+        interest->setMustBeFresh(true);
+        interest->setInterestLifetime(m_options.lifetime);
+
+        m_outstanding.emplace(m_sequence, scheduled + i * interval);
+        pkts.emplace_back(std::move(interest));
+    }
+
+    // Responses hold their credit until receive() pops them on this thread,
+    // so push without waiting and send the rest on a later iteration
+    size_t pushed = 0;
+    if (!m_pipeline->tryPushInterestBulk(0, pkts, pushed)) {
+        m_stop = true;
+        LOG_WARN("unable to push Interest packets");
+        return false;
+    }
 
-    std::shared_ptr<ndn::Data> data(nullptr);
-    while (!m_stop && !m_pipeline->popData(0, data)) {}
+    for (; n > pushed; --n, --m_sequence) {
+        m_outstanding.erase(m_sequence);
+    }
 
-    auto end = ndn::time::system_clock::now();
+    m_counters.nTxInterests += n;
+    return true;
+}
 
-    if (m_stop || data == nullptr) {
+void Client::receive() {
+    auto n = m_pipeline->popDataBulk(0, m_received);
+    if (n == 0) {
         return;
     }
 
-    auto rtt = ndn::time::duration_cast<ndn::time::microseconds>(end - start);
-    LOG_INFO("%s %li us", data->getName().toUri().c_str(), rtt.count());
+    auto now = Clock::now();
+
+    for (size_t i = 0; i < n; ++i) {
+        auto data = std::move(m_received[i]);
+
+        if (data == nullptr) {
+            // The pipeline gave up on an Interest; it cannot tell which one,
+            // so drop the entries that have outlived all retransmissions
+            ++m_counters.nErrors;
+            expire(now);
+            continue;
+        }
+
+        ++m_counters.nRxData;
+
+        uint64_t sequence = 0;
+        try {
+            sequence = data->getName().at(-1).toSequenceNumber();
+        } catch (const ndn::tlv::Error &e) {
+            LOG_WARN("unexpected Data name %s",
+                     data->getName().toUri().c_str());
+            continue;
+        }
+
+        auto it = m_outstanding.find(sequence);
+        if (it == m_outstanding.end()) {
+            continue;
+        }
+
+        auto rtt = now - it->second;
+        m_outstanding.erase(it);
+
+        m_rtt.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(rtt).count()));
+
+        if (!isLoadMode()) {
+            LOG_INFO(
+                "%s %li us", data->getName().toUri().c_str(),
+                std::chrono::duration_cast<std::chrono::microseconds>(rtt)
+                    .count());
+        }
+    }
+}
+
+void Client::expire(Clock::time_point now) {
+    m_lastExpire = now;
+
+    // The pipeline retransmits an Interest up to 8 times before failing
+    auto maxAge = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::milliseconds{m_options.lifetime.count() * 10});
 
-    ++m_counters.nRxData;
+    for (auto it = m_outstanding.begin(); it != m_outstanding.end();) {
+        if (now - it->second > maxAge) {
+            it = m_outstanding.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 Client::Counters Client::getCounters() {
     return m_counters;
 }
+
+const Histogram &Client::getRttHistogram() const {
+    return m_rtt;
+}
+
+Client::Clock::duration Client::getElapsed() const {
+    return (m_stop ? m_end : Clock::now()) - m_start;
+}
 }; // namespace ping
 }; // namespace ndnc
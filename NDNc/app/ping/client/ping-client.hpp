@@ -28,7 +28,11 @@
 #ifndef NDNC_APP_PING_CLIENT_PING_CLIENT_HPP
 #define NDNC_APP_PING_CLIENT_PING_CLIENT_HPP
 
+#include <chrono>
+#include <unordered_map>
+
 #include "congestion-control/pipeline-interests-fixed.hpp"
+#include "utils/histogram.hpp"
 
 namespace ndnc {
 namespace ping {
@@ -39,13 +43,25 @@ struct ClientOptions {
     std::string name;                                  // Name prefix
     ndn::time::milliseconds lifetime =
         ndn::time::seconds{1}; // Interest lifetime
+
+    // Maximum number of Interests in flight. In closed-loop mode this many
+    // Interests are kept outstanding at all times
+    size_t concurrency = 1;
+    // Interests per second. Zero selects closed-loop mode; a positive value
+    // sends at a fixed rate regardless of responses (open-loop)
+    double rate = 0;
+    // Number of Interests to send. Zero means no limit
+    uint64_t count = 0;
 };
 
 class Client : public std::enable_shared_from_this<Client> {
   public:
+    using Clock = std::chrono::steady_clock;
+
     struct Counters {
-        uint32_t nTxInterests = 0;
-        uint32_t nRxData = 0;
+        uint64_t nTxInterests = 0;
+        uint64_t nRxData = 0;
+        uint64_t nErrors = 0;
     };
 
     explicit Client(face::Face &face, ClientOptions options);
@@ -56,6 +72,22 @@ class Client : public std::enable_shared_from_this<Client> {
     bool canContinue();
     Counters getCounters();
 
+    /**
+     * @brief Round-trip times of the received Data packets in nanoseconds
+     *
+     */
+    const Histogram &getRttHistogram() const;
+    Clock::duration getElapsed() const;
+
+  private:
+    bool isLoadMode() const;
+
+    void sendClosedLoop();
+    void sendOpenLoop();
+    bool send(size_t n, Clock::time_point scheduled);
+    void receive();
+    void expire(Clock::time_point now);
+
   private:
     ClientOptions m_options;
     Counters m_counters;
@@ -63,6 +95,15 @@ class Client : public std::enable_shared_from_this<Client> {
     std::shared_ptr<PipelineInterests> m_pipeline;
     uint64_t m_sequence;
     bool m_stop;
+
+    // Send time of each outstanding Interest, by sequence number
+    std::unordered_map<uint64_t, Clock::time_point> m_outstanding;
+    std::vector<std::shared_ptr<ndn::Data>> m_received;
+    Histogram m_rtt;
+
+    Clock::time_point m_start;
+    Clock::time_point m_end;
+    Clock::time_point m_lastExpire;
 };
 }; // namespace ping
 }; // namespace ndnc
@@ -62,6 +62,14 @@ int main(int argc, char **argv) {
         "gqlserver",
         po::value<string>(&opts.gqlserver)->default_value(opts.gqlserver),
         "The GraphQL server address");
+    description.add_options()(
+        "high-performance", po::bool_switch(&opts.highPerformance),
+        "Log only a sample of the received Interests and a periodic summary "
+        "of the counters instead of every Interest");
+    description.add_options()(
+        "log-sample",
+        po::value<uint64_t>(&opts.logSample)->default_value(opts.logSample),
+        "In high-performance mode, log one of every N received Interests");
     description.add_options()(
         "mtu", po::value<size_t>(&opts.mtu)->default_value(opts.mtu),
         "Dataroom size. Specify a positive integer between 64 and 9000");
@@ -76,6 +84,12 @@ int main(int argc, char **argv) {
                "bytes. Specify a positive integer smaller or equal to " +
                to_string(ndn::MAX_NDN_PACKET_SIZE))
             .c_str());
+    description.add_options()(
+        "stats-interval",
+        po::value<chrono::seconds::rep>()->default_value(
+            opts.statsInterval.count()),
+        "In high-performance mode, the interval between counter summaries in "
+        "seconds");
     description.add_options()("help,h", "Print this help message and exit");
 
     po::variables_map vm;
@@ -128,6 +142,20 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (opts.logSample == 0) {
+        cerr << "ERROR: log-sample must be a positive integer\n\n";
+        usage(cout, app, description);
+        return 2;
+    }
+
+    opts.statsInterval =
+        chrono::seconds(vm["stats-interval"].as<chrono::seconds::rep>());
+    if (opts.statsInterval <= chrono::seconds{0}) {
+        cerr << "ERROR: stats-interval must be a positive integer\n\n";
+        usage(cout, app, description);
+        return 2;
+    }
+
     auto face = new ndnc::face::Face();
     if (!face->connect(opts.mtu, opts.gqlserver, "ndncping-server")) {
         return 2;
@@ -141,6 +169,7 @@ int main(int argc, char **argv) {
 
     while (shouldRun && face->isConnected()) {
         face->loop();
+        server->logCounters();
     }
 
     cout << "\n--- statistics --\n"
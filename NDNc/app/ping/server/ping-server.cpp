@@ -27,22 +27,37 @@
 
 #include <boost/lexical_cast.hpp>
 
-#include <ndn-cxx/signature-info.hpp>
-#include <ndn-cxx/util/sha256.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 #include "logger/logger.hpp"
 #include "ping-server.hpp"
+#include "security/digest-sha256.hpp"
+#include "security/sha256.hpp"
 
 namespace ndnc {
 namespace ping {
 Server::Server(face::Face &face, ServerOptions options)
-    : PacketHandler(face), m_options{options}, m_counters{}, m_signatureInfo{} {
+    : PacketHandler(face), m_options{options}, m_counters{},
+      m_lastCounters{}, m_lastStats{std::chrono::steady_clock::now()} {
 
     auto buff = std::make_unique<ndn::Buffer>();
     buff->assign(m_options.payloadLength, 'p');
-    m_payload = ndn::Block(ndn::tlv::Content, std::move(buff));
 
-    m_signatureInfo.setSignatureType(ndn::tlv::DigestSha256);
+    // Every Data packet differs only by name, so encode one with an empty
+    // name and keep the fields between the Name and the SignatureValue
+    ndn::Data data{ndn::Name()};
+    data.setContent(ndn::Block(ndn::tlv::Content, std::move(buff)));
+    data.setContentType(ndn::tlv::ContentType_Blob);
+    data.setFreshnessPeriod(ndn::time::seconds{2});
+
+    auto wire = ndnc::security::signDigest(data);
+    wire.parse();
+
+    auto first = wire.find(ndn::tlv::MetaInfo);
+    auto last = wire.find(ndn::tlv::SignatureInfo);
+    m_dataTemplate.assign(first->begin(), last->end());
+
+    m_options.logSample = std::max<uint64_t>(m_options.logSample, 1);
 }
 
 Server::~Server() {
@@ -52,18 +67,15 @@ void Server::onInterest(std::shared_ptr<ndn::Interest> &&interest,
                         ndn::lp::PitToken &&pitToken) {
     ++m_counters.nRxInterests;
 
-    LOG_INFO("%s %s", boost::lexical_cast<std::string>(pitToken).c_str(),
-             interest->getName().toUri().c_str());
-
-    auto data = std::make_shared<ndn::Data>(interest->getName());
-    data->setContent(m_payload);
-    data->setContentType(ndn::tlv::ContentType_Blob);
-    data->setSignatureInfo(m_signatureInfo);
-    data->setSignatureValue(std::make_shared<ndn::Buffer>());
-    data->setFreshnessPeriod(ndn::time::seconds{2});
+    if (!m_options.highPerformance ||
+        (m_counters.nRxInterests - 1) % m_options.logSample == 0) {
+        LOG_INFO("%s %s", boost::lexical_cast<std::string>(pitToken).c_str(),
+                 interest->getName().toUri().c_str());
+    }
 
+    // Queued on the face and sent at the end of the RX burst
     if (face != nullptr &&
-        !face->send(getWireEncode(std::move(data), std::move(pitToken)))) {
+        face->send(encodeData(interest->getName(), pitToken)) < 0) {
         LOG_WARN("unable to send Data packet on face");
         return;
     }
@@ -71,6 +83,64 @@ void Server::onInterest(std::shared_ptr<ndn::Interest> &&interest,
     ++m_counters.nTxData;
 }
 
+ndn::Block Server::encodeData(const ndn::Name &name,
+                              const ndn::lp::PitToken &pitToken) {
+    auto &nameWire = name.wireEncode();
+
+    // Room for the TLV headers in front and the SignatureValue at the back
+    ndn::EncodingBuffer encoder(
+        nameWire.size() + m_dataTemplate.size() + pitToken.size() + 96, 40);
+
+    encoder.prependBytes(m_dataTemplate);
+    encoder.prependBytes(ndn::make_span(nameWire.wire(), nameWire.size()));
+
+    // DigestSha256 covers the name, so it is the one computed field
+    uint8_t digest[ndnc::security::SHA256_DIGEST_SIZE];
+    ndnc::security::sha256(encoder.data(), encoder.size(), digest);
+
+    encoder.appendVarNumber(ndn::tlv::SignatureValue);
+    encoder.appendVarNumber(sizeof(digest));
+    encoder.appendBytes(ndn::make_span(digest));
+
+    encoder.prependVarNumber(encoder.size());
+    encoder.prependVarNumber(ndn::tlv::Data);
+
+    // Fragment is the last field of the LpPacket
+    encoder.prependVarNumber(encoder.size());
+    encoder.prependVarNumber(ndn::lp::tlv::Fragment);
+
+    ndn::encoding::prependBinaryBlock(
+        encoder, ndn::lp::tlv::PitToken,
+        ndn::make_span(pitToken.data(), pitToken.size()));
+
+    encoder.prependVarNumber(encoder.size());
+    encoder.prependVarNumber(ndn::lp::tlv::LpPacket);
+
+    return encoder.block();
+}
+
+void Server::logCounters() {
+    if (!m_options.highPerformance) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = now - m_lastStats;
+
+    if (elapsed < m_options.statsInterval) {
+        return;
+    }
+
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+    LOG_INFO("rx=%lu tx=%lu rx_rate=%.0f pps tx_rate=%.0f pps",
+             m_counters.nRxInterests, m_counters.nTxData,
+             (m_counters.nRxInterests - m_lastCounters.nRxInterests) / seconds,
+             (m_counters.nTxData - m_lastCounters.nTxData) / seconds);
+
+    m_lastCounters = m_counters;
+    m_lastStats = now;
+}
+
 Server::Counters Server::getCounters() {
     return m_counters;
 }
@@ -28,6 +28,9 @@
 #ifndef NDNC_APP_PING_SERVER_PING_SERVER_HPP
 #define NDNC_APP_PING_SERVER_PING_SERVER_HPP
 
+#include <chrono>
+#include <vector>
+
 #include "face/packet-handler.hpp"
 
 namespace ndnc {
@@ -38,14 +41,22 @@ struct ServerOptions {
     std::string gqlserver = "http://localhost:3030/"; // GraphQL server address
     std::string name;                                 // Name prefix
     size_t payloadLength = 0;                         // Payload length
+
+    // Replace per-packet logging with sampled logging and periodic counter
+    // summaries
+    bool highPerformance = false;
+    // Log one of every logSample Interests in high-performance mode
+    uint64_t logSample = 65536;
+    // Interval between counter summaries in high-performance mode
+    std::chrono::seconds statsInterval{1};
 };
 
 class Server : public PacketHandler,
                public std::enable_shared_from_this<Server> {
   public:
     struct Counters {
-        uint32_t nRxInterests = 0;
-        uint32_t nTxData = 0;
+        uint64_t nRxInterests = 0;
+        uint64_t nTxData = 0;
     };
 
     explicit Server(face::Face &face, ServerOptions options);
@@ -53,16 +64,35 @@ class Server : public PacketHandler,
 
     Counters getCounters();
 
+    /**
+     * @brief Log the counters if the stats interval has elapsed. Does nothing
+     * outside high-performance mode
+     *
+     */
+    void logCounters();
+
   private:
     void onInterest(std::shared_ptr<ndn::Interest> &&interest,
                     ndn::lp::PitToken &&pitToken) final;
 
+    /**
+     * @brief Encode the LpPacket answering an Interest from the Data
+     * template. Only the name, the PIT token and the digest change between
+     * packets
+     *
+     */
+    ndn::Block encodeData(const ndn::Name &name,
+                          const ndn::lp::PitToken &pitToken);
+
   private:
     ServerOptions m_options;
     Counters m_counters;
 
-    ndn::Block m_payload;
-    ndn::SignatureInfo m_signatureInfo;
+    // Encoded MetaInfo, Content and SignatureInfo shared by all Data packets
+    std::vector<uint8_t> m_dataTemplate;
+
+    Counters m_lastCounters;
+    std::chrono::steady_clock::time_point m_lastStats;
 };
 }; // namespace ping
 }; // namespace ndnc
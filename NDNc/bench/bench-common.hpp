@@ -0,0 +1,74 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_BENCH_BENCH_COMMON_HPP
+#define NDNC_BENCH_BENCH_COMMON_HPP
+
+#include <memory>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/lp/pit-token.hpp>
+
+#include "security/digest-sha256.hpp"
+
+namespace ndnc::bench {
+static constexpr size_t SEGMENT_SIZE = 8192;
+
+inline ndn::Name getSegmentName(uint64_t segment) {
+    return ndn::Name("/ndnc/bench/file").appendVersion(1).appendSegment(
+        segment);
+}
+
+inline std::shared_ptr<ndn::Interest> makeInterest(uint64_t segment) {
+    auto interest = std::make_shared<ndn::Interest>(getSegmentName(segment));
+    interest->setInterestLifetime(ndn::time::milliseconds{2000});
+    return interest;
+}
+
+inline ndn::lp::PitToken makePitToken(uint64_t value) {
+    ndn::Buffer b(&value, sizeof(value));
+    return ndn::lp::PitToken(std::make_pair(b.begin(), b.end()));
+}
+
+/**
+ * @brief Make a signed and encoded Data packet with size bytes of content
+ *
+ */
+inline std::shared_ptr<ndn::Data> makeData(uint64_t segment,
+                                           size_t size = SEGMENT_SIZE) {
+    std::vector<uint8_t> content(size, static_cast<uint8_t>(segment));
+
+    auto data = std::make_shared<ndn::Data>(getSegmentName(segment));
+    data->setContent(content);
+    security::signDigest(*data);
+    return data;
+}
+}; // namespace ndnc::bench
+
+#endif // NDNC_BENCH_BENCH_COMMON_HPP
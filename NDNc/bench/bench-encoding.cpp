@@ -0,0 +1,111 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench-common.hpp"
+#include "codecs/encoding.hpp"
+#include "lib/posix/file-metadata.hpp"
+
+namespace ndnc::bench {
+static void BM_InterestWireEncode(benchmark::State &state) {
+    auto interest = makeInterest(42);
+    uint64_t pitToken = 0;
+
+    for (auto _ : state) {
+        // getWireEncode consumes the Interest
+        auto copy = std::make_shared<ndn::Interest>(*interest);
+        benchmark::DoNotOptimize(getWireEncode(std::move(copy), ++pitToken));
+    }
+}
+BENCHMARK(BM_InterestWireEncode);
+
+static void BM_InterestWireDecode(benchmark::State &state) {
+    auto wire = getWireEncode(makeInterest(42), 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getWireDecode(wire));
+    }
+}
+BENCHMARK(BM_InterestWireDecode);
+
+static void BM_DataWireEncode(benchmark::State &state) {
+    auto data = makeData(42, state.range(0));
+    auto pitToken = makePitToken(1);
+
+    for (auto _ : state) {
+        auto copy = std::make_shared<ndn::Data>(*data);
+        benchmark::DoNotOptimize(getWireEncode(
+            std::move(copy), ndn::lp::PitToken(pitToken)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DataWireEncode)->Arg(1024)->Arg(SEGMENT_SIZE);
+
+static void BM_DataWireEncodePreEncoded(benchmark::State &state) {
+    auto data = makeData(42, state.range(0));
+    auto pitToken = makePitToken(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getWireEncode(data->wireEncode(), pitToken));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DataWireEncodePreEncoded)->Arg(1024)->Arg(SEGMENT_SIZE);
+
+static void BM_FileMetadataEncode(benchmark::State &state) {
+    posix::FileMetadata metadata(SEGMENT_SIZE);
+    if (!metadata.prepare("/proc/self/exe", ndn::Name("/ndnc/bench/file"))) {
+        state.SkipWithError("unable to stat /proc/self/exe");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(metadata.encode());
+    }
+}
+BENCHMARK(BM_FileMetadataEncode);
+
+static void BM_FileMetadataDecode(benchmark::State &state) {
+    posix::FileMetadata metadata(SEGMENT_SIZE);
+    if (!metadata.prepare("/proc/self/exe", ndn::Name("/ndnc/bench/file"))) {
+        state.SkipWithError("unable to stat /proc/self/exe");
+        return;
+    }
+    auto content = metadata.encode();
+
+    for (auto _ : state) {
+        // A fresh Block, as received from the network, so it gets parsed
+        ndn::Block wire(ndn::make_span(content.wire(), content.size()));
+        posix::FileMetadata decoded(wire);
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+BENCHMARK(BM_FileMetadataDecode);
+}; // namespace ndnc::bench
@@ -0,0 +1,111 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench-common.hpp"
+#include "face/face.hpp"
+
+namespace ndnc::bench {
+/**
+ * @brief Gives the benchmarks access to the private Face::receive
+ *
+ */
+class FaceAccess {
+  public:
+    static void receive(face::Face &face, const ndn::Block &&pkt) {
+        face.receive(std::move(pkt));
+    }
+};
+
+namespace {
+class CountingHandler : public PacketHandler {
+  public:
+    explicit CountingHandler(face::Face &face) : PacketHandler(face) {
+    }
+
+    void onInterest(std::shared_ptr<ndn::Interest> &&,
+                    ndn::lp::PitToken &&) final {
+        ++count;
+    }
+
+    void onData(std::shared_ptr<ndn::Data> &&, ndn::lp::PitToken &&) final {
+        ++count;
+    }
+
+    void onNack(std::shared_ptr<ndn::lp::Nack> &&,
+                ndn::lp::PitToken &&) final {
+        ++count;
+    }
+
+  public:
+    uint64_t count = 0;
+};
+
+/**
+ * @brief Feed an encoded LpPacket to Face::receive as the transport does
+ *
+ */
+void receive(benchmark::State &state, const ndn::Block &wire) {
+    face::Face face;
+    CountingHandler handler(face);
+
+    for (auto _ : state) {
+        FaceAccess::receive(face, ndn::Block(wire));
+    }
+
+    if (handler.count != static_cast<uint64_t>(state.iterations())) {
+        state.SkipWithError("packets were not dispatched");
+    }
+    state.SetBytesProcessed(state.iterations() * wire.size());
+}
+}; // namespace
+
+static void BM_FaceReceiveData(benchmark::State &state) {
+    receive(state, getWireEncode(makeData(42, state.range(0)),
+                                 makePitToken(1)));
+}
+BENCHMARK(BM_FaceReceiveData)->Arg(1024)->Arg(SEGMENT_SIZE);
+
+static void BM_FaceReceiveInterest(benchmark::State &state) {
+    receive(state, getWireEncode(makeInterest(42), 1));
+}
+BENCHMARK(BM_FaceReceiveInterest);
+
+static void BM_FaceReceiveNack(benchmark::State &state) {
+    auto interest = makeInterest(42);
+    ndn::lp::Nack nack(*interest);
+    nack.setReason(ndn::lp::NackReason::DUPLICATE);
+
+    ndn::lp::Packet lpPacket(interest->wireEncode());
+    lpPacket.add<ndn::lp::NackField>(nack.getHeader());
+    lpPacket.add<ndn::lp::PitTokenField>(makePitToken(1));
+
+    receive(state, lpPacket.wireEncode());
+}
+BENCHMARK(BM_FaceReceiveNack);
+}; // namespace ndnc::bench
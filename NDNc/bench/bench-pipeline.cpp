@@ -0,0 +1,127 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include "bench-common.hpp"
+#include "congestion-control/pending-interest.hpp"
+
+namespace ndnc::bench {
+static void BM_PendingInterestConstruct(benchmark::State &state) {
+    auto interest = makeInterest(42);
+    uint64_t pitToken = 0;
+
+    for (auto _ : state) {
+        auto copy = std::make_shared<ndn::Interest>(*interest);
+        PendingInterest pendingInterest(std::move(copy), ++pitToken, 0);
+        benchmark::DoNotOptimize(pendingInterest);
+    }
+}
+BENCHMARK(BM_PendingInterestConstruct);
+
+static void BM_PendingInterestRefresh(benchmark::State &state) {
+    PendingInterest pendingInterest(makeInterest(42), 0, 0);
+    uint64_t pitToken = 0;
+
+    for (auto _ : state) {
+        pendingInterest.refresh(++pitToken, false);
+    }
+}
+BENCHMARK(BM_PendingInterestRefresh);
+
+/**
+ * @brief Steady state of the PIT: each iteration satisfies the oldest entry
+ * and inserts a new one, with range(0) entries outstanding
+ *
+ */
+static void BM_PITInsertLookup(benchmark::State &state) {
+    std::unordered_map<uint64_t, PendingInterest> pit;
+    auto pendingInterest = PendingInterest(makeInterest(42), 0, 0);
+
+    uint64_t oldest = 0, next = 0;
+    for (; next < static_cast<uint64_t>(state.range(0)); ++next) {
+        pit.emplace(next, pendingInterest);
+    }
+
+    for (auto _ : state) {
+        auto it = pit.find(oldest++);
+        benchmark::DoNotOptimize(it);
+        pit.erase(it);
+
+        pit.emplace(next++, pendingInterest);
+    }
+}
+BENCHMARK(BM_PITInsertLookup)->Arg(1024)->Arg(65536);
+
+/**
+ * @brief Bulk enqueue and dequeue of range(0) Interests, as consumers push
+ * and the pipeline worker pops them
+ *
+ */
+static void BM_RequestQueue(benchmark::State &state) {
+    RequestQueue queue;
+    size_t batch = state.range(0);
+
+    std::vector<PendingInterest> in(batch,
+                                    PendingInterest(makeInterest(42), 0, 0));
+    std::vector<PendingInterest> out(batch);
+
+    for (auto _ : state) {
+        queue.enqueue_bulk(in.begin(), batch);
+        benchmark::DoNotOptimize(queue.try_dequeue_bulk(out.begin(), batch));
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_RequestQueue)->Arg(1)->Arg(64);
+
+/**
+ * @brief Data hand-off from the pipeline worker to consumers. With several
+ * threads, all of them share one queue
+ *
+ */
+static void BM_ResponseQueue(benchmark::State &state) {
+    static ResponseQueue queue;
+    size_t batch = state.range(0);
+
+    std::vector<std::shared_ptr<ndn::Data>> in(batch, makeData(42, 0));
+    std::vector<std::shared_ptr<ndn::Data>> out(batch);
+
+    for (auto _ : state) {
+        queue.enqueue_bulk(in.begin(), batch);
+
+        for (size_t n = 0; n < batch;) {
+            n += queue.try_dequeue_bulk(out.begin(), batch - n);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_ResponseQueue)->Arg(1)->Arg(64)->ThreadRange(1, 4);
+}; // namespace ndnc::bench
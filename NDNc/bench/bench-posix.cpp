@@ -0,0 +1,117 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "bench-common.hpp"
+#include "lib/posix/read-assembler.hpp"
+
+namespace ndnc::bench {
+/**
+ * @brief Reassembly of a File::read of range(0) segments from Data packets
+ * arriving out of order, into one unaligned destination buffer
+ *
+ */
+static void BM_ReadAssembly(benchmark::State &state) {
+    size_t nSegments = state.range(0);
+    uint64_t fileSize = nSegments * SEGMENT_SIZE;
+
+    std::vector<std::shared_ptr<ndn::Data>> pkts;
+    for (size_t i = 0; i < nSegments; ++i) {
+        pkts.push_back(makeData(i));
+    }
+    std::shuffle(pkts.begin(), pkts.end(), std::mt19937{42});
+
+    // Start and end in the middle of a segment, like most xrootd reads
+    std::vector<uint8_t> buffer(fileSize);
+    posix::ReadChunk chunk{buffer.data(), SEGMENT_SIZE / 2,
+                           fileSize - SEGMENT_SIZE};
+
+    for (auto _ : state) {
+        posix::ReadAssembler assembler(&chunk, 1, SEGMENT_SIZE, fileSize);
+
+        for (auto &pkt : pkts) {
+            assembler.add(*pkt);
+        }
+
+        if (!assembler.isComplete()) {
+            state.SkipWithError("read was not reassembled");
+            break;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * chunk.len);
+}
+BENCHMARK(BM_ReadAssembly)->Arg(16)->Arg(128);
+
+/**
+ * @brief Reassembly of a vectored read of range(0) chunks of 4 KiB spread
+ * over the file
+ *
+ */
+static void BM_ReadAssemblyVectored(benchmark::State &state) {
+    size_t nChunks = state.range(0);
+    uint64_t fileSize = nChunks * 4 * SEGMENT_SIZE;
+
+    std::vector<uint8_t> buffer(nChunks * 4096);
+    std::vector<posix::ReadChunk> chunks;
+    for (size_t i = 0; i < nChunks; ++i) {
+        chunks.push_back(posix::ReadChunk{
+            buffer.data() + i * 4096,
+            static_cast<off_t>(i * 4 * SEGMENT_SIZE + SEGMENT_SIZE - 2048),
+            4096});
+    }
+
+    posix::ReadAssembler layout(chunks.data(), chunks.size(), SEGMENT_SIZE,
+                                fileSize);
+
+    std::vector<std::shared_ptr<ndn::Data>> pkts;
+    for (auto segment : layout.getSegments()) {
+        pkts.push_back(makeData(segment));
+    }
+
+    for (auto _ : state) {
+        posix::ReadAssembler assembler(chunks.data(), chunks.size(),
+                                       SEGMENT_SIZE, fileSize);
+
+        for (auto &pkt : pkts) {
+            assembler.add(*pkt);
+        }
+
+        if (!assembler.isComplete()) {
+            state.SkipWithError("read was not reassembled");
+            break;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_ReadAssemblyVectored)->Arg(16)->Arg(128);
+}; // namespace ndnc::bench
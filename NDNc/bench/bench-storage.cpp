@@ -0,0 +1,147 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <random>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "app/file-transfer/server/ft-storage-engine-pread.hpp"
+#include "app/file-transfer/server/ft-storage-engine-uring.hpp"
+#include "bench-common.hpp"
+
+namespace ndnc::bench {
+namespace {
+using namespace ndnc::app::filetransfer;
+
+static constexpr size_t BATCH_SIZE = 256;
+static constexpr size_t FILE_SEGMENTS = 8192;
+
+/**
+ * @brief Open the file to read segments from: NDNC_BENCH_FILE when set, e.g.
+ * a large file on the NVMe drive being measured, otherwise a 64 MiB
+ * temporary file which is most likely served from the page cache
+ *
+ */
+std::shared_ptr<OpenFile> openBenchFile() {
+    auto path = std::getenv("NDNC_BENCH_FILE");
+    int fd = -1;
+
+    if (path != nullptr) {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } else {
+        char tmp[] = "/tmp/ndnc-bench-XXXXXX";
+        fd = ::mkstemp(tmp);
+        if (fd >= 0) {
+            ::unlink(tmp);
+
+            std::vector<uint8_t> segment(SEGMENT_SIZE, 0xA5);
+            for (size_t i = 0; i < FILE_SEGMENTS; ++i) {
+                if (::pwrite(fd, segment.data(), segment.size(),
+                             i * SEGMENT_SIZE) < 0) {
+                    ::close(fd);
+                    return nullptr;
+                }
+            }
+        }
+    }
+
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    auto size = ::lseek(fd, 0, SEEK_END);
+    if (size < static_cast<off_t>(SEGMENT_SIZE)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    return std::make_shared<OpenFile>(fd, 0, 0, size);
+}
+
+/**
+ * @brief Read batches of random segments, as the server worker does for
+ * Interests of several concurrent transfers
+ *
+ */
+void readSegments(benchmark::State &state, StorageEngine &engine) {
+    auto file = openBenchFile();
+    if (file == nullptr) {
+        state.SkipWithError("unable to open the benchmark file");
+        return;
+    }
+
+    auto nSegments = file->size / SEGMENT_SIZE;
+    std::mt19937_64 random{42};
+    std::vector<std::unique_ptr<ReadRequest>> completed;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            auto segment = random() % nSegments;
+            engine.submit(std::make_unique<ReadRequest>(
+                getSegmentName(segment), makePitToken(segment), file,
+                segment * SEGMENT_SIZE, SEGMENT_SIZE, nSegments - 1));
+        }
+
+        for (size_t n = 0; n < BATCH_SIZE;) {
+            completed.clear();
+            n += engine.poll(completed);
+
+            for (auto &request : completed) {
+                if (!request->ok) {
+                    state.SkipWithError("segment read failed");
+                }
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    state.SetBytesProcessed(state.iterations() * BATCH_SIZE * SEGMENT_SIZE);
+}
+}; // namespace
+
+static void BM_StorageEnginePread(benchmark::State &state) {
+    StorageEnginePread engine(state.range(0));
+    readSegments(state, engine);
+}
+BENCHMARK(BM_StorageEnginePread)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+#ifdef NDNC_WITH_IO_URING
+static void BM_StorageEngineUring(benchmark::State &state) {
+    StorageEngineUring engine(state.range(0), SEGMENT_SIZE);
+    if (!engine.isValid()) {
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+
+    readSegments(state, engine);
+}
+BENCHMARK(BM_StorageEngineUring)->Arg(16)->Arg(64)->Arg(256)->UseRealTime();
+#endif // NDNC_WITH_IO_URING
+}; // namespace ndnc::bench
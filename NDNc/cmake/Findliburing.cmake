@@ -0,0 +1,28 @@
+function(print_message mode VALUE)
+  if(NOT liburing_FIND_QUIETLY)
+    message(${mode} ${VALUE})
+  endif()
+endfunction()
+
+
+# search for liburing.h
+print_message(STATUS "Looking for liburing.h")
+find_path(LIBURING_INCLUDES liburing.h
+          HINTS "/usr/" "/usr/local/"
+          PATH_SUFFIXES "include")
+
+# search for liburing.so
+print_message(STATUS "Looking for liburing")
+find_library(LIBURING_LIB uring HINTS "/usr/" "/usr/local/" "/usr/local/lib")
+
+if(LIBURING_INCLUDES AND LIBURING_LIB)
+  print_message(STATUS "Looking for liburing - found: ${LIBURING_LIB}")
+  set(LIBURING-FOUND TRUE)
+else()
+  print_message(STATUS "Looking for liburing - not found")
+  set(LIBURING-FOUND FALSE)
+endif()
+
+if(liburing_FIND_REQUIRED AND NOT LIBURING-FOUND)
+  message(FATAL_ERROR "liburing not found")
+endif()
@@ -29,6 +29,8 @@
 #define NDNC_CODECS_ENCODING_HPP
 
 #include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/interest.hpp>
 
 #include <ndn-cxx/lp/nack.hpp>
@@ -66,6 +68,29 @@ inline ndn::Block getWireEncode(std::shared_ptr<ndn::Data> &&data,
 
     return lpPacket.wireEncode();
 }
+
+/**
+ * @brief Wrap an already encoded Data packet in an LpPacket carrying the PIT
+ * token, without decoding or re-encoding the Data packet
+ *
+ */
+inline ndn::Block getWireEncode(const ndn::Block &data,
+                                const ndn::lp::PitToken &pitToken) {
+    ndn::EncodingBuffer encoder(data.size() + pitToken.size() + 16, 0);
+
+    // Fragment is the last field of the LpPacket
+    size_t length = ndn::encoding::prependBinaryBlock(
+        encoder, ndn::lp::tlv::Fragment,
+        ndn::make_span(data.wire(), data.size()));
+    length += ndn::encoding::prependBinaryBlock(
+        encoder, ndn::lp::tlv::PitToken,
+        ndn::make_span(pitToken.data(), pitToken.size()));
+
+    encoder.prependVarNumber(length);
+    encoder.prependVarNumber(ndn::lp::tlv::LpPacket);
+
+    return encoder.block();
+}
 } // namespace ndnc
 
 namespace ndnc {
@@ -0,0 +1,134 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "data-verifier.hpp"
+#include "logger/logger.hpp"
+#include "security/digest-sha256.hpp"
+
+namespace ndnc {
+static const size_t VERIFY_BATCH_SIZE = 64;
+
+DataVerifier::DataVerifier(size_t threads)
+    : validators_{std::make_shared<const Validators>()},
+      acceptUnknown_{false}, stop_{false} {
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(&DataVerifier::run, this);
+    }
+}
+
+DataVerifier::~DataVerifier() {
+    stop_ = true;
+
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void DataVerifier::setValidator(uint32_t signatureType, Validator validator) {
+    // Serialize writers; readers keep using the previous map until swapped
+    std::lock_guard<std::mutex> lock(validatorsMtx_);
+
+    auto validators = std::make_shared<Validators>(*validators_);
+    (*validators)[signatureType] = validator;
+
+    std::atomic_store(&validators_,
+                      std::shared_ptr<const Validators>(std::move(validators)));
+}
+
+void DataVerifier::setAcceptUnknownSignatureTypes(bool accept) {
+    acceptUnknown_ = accept;
+}
+
+bool DataVerifier::submit(VerifyRequest &&request) {
+    return pending_.enqueue(std::move(request));
+}
+
+size_t DataVerifier::poll(std::vector<VerifyRequest> &completed) {
+    auto offset = completed.size();
+    completed.resize(offset + VERIFY_BATCH_SIZE);
+
+    auto n = completed_.try_dequeue_bulk(completed.begin() + offset,
+                                         VERIFY_BATCH_SIZE);
+    completed.resize(offset + n);
+
+    return n;
+}
+
+void DataVerifier::run() {
+    std::vector<VerifyRequest> batch(VERIFY_BATCH_SIZE);
+
+    while (!stop_) {
+        auto n = pending_.wait_dequeue_bulk_timed(
+            batch.begin(), VERIFY_BATCH_SIZE, std::chrono::milliseconds(10));
+
+        if (n == 0) {
+            continue;
+        }
+
+        verify(batch, n);
+        completed_.enqueue_bulk(std::make_move_iterator(batch.begin()), n);
+    }
+}
+
+void DataVerifier::verify(std::vector<VerifyRequest> &batch, size_t n) {
+    auto validators = std::atomic_load(&validators_);
+    auto acceptUnknown = acceptUnknown_.load();
+
+    std::vector<size_t> index;
+    std::vector<std::shared_ptr<ndn::Data>> digests;
+
+    for (size_t i = 0; i < n; ++i) {
+        auto type = batch[i].data->getSignatureType();
+        auto it = validators->find(type);
+
+        if (it != validators->end()) {
+            batch[i].ok = it->second(*batch[i].data);
+        } else if (type == ndn::tlv::DigestSha256) {
+            index.push_back(i);
+            digests.push_back(batch[i].data);
+        } else {
+            batch[i].ok = acceptUnknown;
+            if (!acceptUnknown) {
+                LOG_DEBUG("no validator for signature type %d", type);
+            }
+        }
+    }
+
+    if (digests.empty()) {
+        return;
+    }
+
+    std::vector<bool> valid;
+    ndnc::security::verifyDigestBatch(digests, digests.size(), valid);
+
+    for (size_t k = 0; k < index.size(); ++k) {
+        batch[index[k]].ok = valid[k];
+    }
+}
+}; // namespace ndnc
@@ -0,0 +1,106 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_CONGESTION_CONTROL_DATA_VERIFIER_HPP
+#define NDNC_CONGESTION_CONTROL_DATA_VERIFIER_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "pending-interest.hpp"
+
+namespace ndnc {
+struct VerifyRequest {
+    std::shared_ptr<ndn::Data> data;
+    PendingInterest pendingInterest;
+    bool ok = false;
+};
+
+/**
+ * @brief Verifies the signature of Data packets on a small thread pool, off
+ * the pipeline thread. DigestSha256 is checked in batches; other signature
+ * types are checked by the validator registered for them and rejected when
+ * there is none, unless unknown types are explicitly accepted
+ *
+ */
+class DataVerifier {
+  public:
+    using Validator = std::function<bool(const ndn::Data &)>;
+    using Validators = std::unordered_map<uint32_t, Validator>;
+
+  public:
+    explicit DataVerifier(size_t threads);
+    ~DataVerifier();
+
+    /**
+     * @brief Register the validator for a signature type, replacing any
+     * previous one, including the built-in DigestSha256 check
+     *
+     */
+    void setValidator(uint32_t signatureType, Validator validator);
+
+    /**
+     * @brief Accept Data packets whose signature type has no validator,
+     * including a missing or corrupted SignatureType. Off by default
+     *
+     */
+    void setAcceptUnknownSignatureTypes(bool accept);
+
+    bool submit(VerifyRequest &&request);
+
+    /**
+     * @brief Move verified requests to completed. Never blocks
+     *
+     * @return size_t The number of requests moved
+     */
+    size_t poll(std::vector<VerifyRequest> &completed);
+
+  private:
+    void run();
+    void verify(std::vector<VerifyRequest> &batch, size_t n);
+
+  private:
+    moodycamel::BlockingConcurrentQueue<VerifyRequest> pending_;
+    moodycamel::ConcurrentQueue<VerifyRequest> completed_;
+
+    // Replaced as a whole by setValidator; workers take a reference per
+    // batch with std::atomic_load
+    std::shared_ptr<const Validators> validators_;
+    std::mutex validatorsMtx_;
+    std::atomic_bool acceptUnknown_;
+
+    std::atomic_bool stop_;
+    std::vector<std::thread> workers_;
+};
+}; // namespace ndnc
+
+#endif // NDNC_CONGESTION_CONTROL_DATA_VERIFIER_HPP
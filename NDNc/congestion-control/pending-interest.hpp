@@ -31,6 +31,7 @@
 #include <ndn-cxx/util/time.hpp>
 
 #include "pipeline-common.hpp"
+#include "telemetry/tracer.hpp"
 
 namespace ndnc {
 class PendingInterest {
@@ -44,6 +45,12 @@ class PendingInterest {
         m_consumerId = consumerId;
         m_retriesCount = 0;
         m_interestLifetime = interest->getInterestLifetime();
+
+        m_span = telemetry::Tracer::instance().sample(consumerId);
+        if (m_span != nullptr) {
+            m_span->name = interest->getName().toUri();
+        }
+
         m_interest = getWireEncode(std::move(interest), pitTokenValue);
     }
 
@@ -54,15 +61,15 @@ class PendingInterest {
         return m_pitTokenValue;
     }
 
-    uint64_t getConsumerId() {
+    uint64_t getConsumerId() const {
         return m_consumerId;
     }
 
-    uint64_t getRetriesCount() {
+    uint64_t getRetriesCount() const {
         return m_retriesCount;
     }
 
-    bool hasReachedMaximumNumOfRetries() {
+    bool hasReachedMaximumNumOfRetries() const {
         return m_retriesCount >= 8;
     }
 
@@ -80,6 +87,18 @@ class PendingInterest {
 
     void markAsExpressed() {
         expressedAt = ndn::time::steady_clock::now();
+
+        if (m_span != nullptr) {
+            m_span->markTx();
+        }
+    }
+
+    /**
+     * @brief Get the trace span of a sampled Interest, nullptr otherwise
+     *
+     */
+    const std::shared_ptr<telemetry::TraceSpan> &getTraceSpan() const {
+        return m_span;
     }
 
     inline ndn::time::milliseconds getTimeSinceExpressed() const {
@@ -87,6 +106,13 @@ class PendingInterest {
             ndn::time::steady_clock::now() - expressedAt);
     }
 
+    inline uint64_t getNanosecondsSinceExpressed() const {
+        return static_cast<uint64_t>(
+            ndn::time::duration_cast<ndn::time::nanoseconds>(
+                ndn::time::steady_clock::now() - expressedAt)
+                .count());
+    }
+
     void refresh(uint64_t pitTokenValue, bool timeoutReason) {
         auto interest = this->getInterest();
         interest->refreshNonce();
@@ -106,6 +132,7 @@ class PendingInterest {
     ndn::Block m_interest;
     ndn::time::milliseconds m_interestLifetime;
     ndn::time::steady_clock::TimePoint expressedAt;
+    std::shared_ptr<telemetry::TraceSpan> m_span;
 };
 }; // namespace ndnc
 
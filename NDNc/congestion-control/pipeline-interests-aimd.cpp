@@ -30,9 +30,12 @@
 
 namespace ndnc {
 PipelineInterestsAimd::PipelineInterestsAimd(face::Face &face,
-                                             size_t windowSize)
-    : PipelineInterests(face), m_ssthresh{windowSize}, m_windowSize{64},
-      m_windowIncCounter{0}, m_lastDecrease{ndn::time::steady_clock::now()} {
+                                             size_t windowSize,
+                                             size_t verifyThreads,
+                                             size_t maxPendingInterests)
+    : PipelineInterests(face, verifyThreads, maxPendingInterests),
+      m_ssthresh{windowSize}, m_windowSize{64}, m_windowIncCounter{0},
+      m_lastDecrease{ndn::time::steady_clock::now()} {
 }
 
 PipelineInterestsAimd::~PipelineInterestsAimd() {
@@ -53,7 +56,9 @@ void PipelineInterestsAimd::open() {
 
     while (!isClosed()) {
         face->loop();
+        onVerifiedData();
         onTimeout();
+        updateGauges(m_windowSize);
 
         if (m_pit->size() >= m_windowSize) {
             continue; // Wait for data packets
@@ -109,10 +114,10 @@ void PipelineInterestsAimd::onData(std::shared_ptr<ndn::Data> &&data,
         LOG_DEBUG("ECN received");
     }
 
-    m_counters.delay += it->second.getTimeSinceExpressed();
+    m_counters.recordDelay(it->second.getNanosecondsSinceExpressed());
 
-    // Enqueue Data into Response queue
-    if (!pushData(it->second.getConsumerId(), std::move(data))) {
+    // Enqueue Data into the response queue, once verified if enabled
+    if (!deliverData(it->second, std::move(data))) {
         this->close();
         return;
     }
@@ -33,7 +33,9 @@
 namespace ndnc {
 class PipelineInterestsAimd : public PipelineInterests {
   public:
-    PipelineInterestsAimd(face::Face &face, size_t windowSize);
+    PipelineInterestsAimd(face::Face &face, size_t windowSize,
+                          size_t verifyThreads = 0,
+                          size_t maxPendingInterests = 65536);
     ~PipelineInterestsAimd();
 
   private:
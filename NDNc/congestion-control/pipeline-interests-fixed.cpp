@@ -30,8 +30,11 @@
 
 namespace ndnc {
 PipelineInterestsFixed::PipelineInterestsFixed(face::Face &face,
-                                               size_t windowSize)
-    : PipelineInterests(face), m_windowSize{windowSize} {
+                                               size_t windowSize,
+                                               size_t verifyThreads,
+                                               size_t maxPendingInterests)
+    : PipelineInterests(face, verifyThreads, maxPendingInterests),
+      m_windowSize{windowSize} {
 }
 
 PipelineInterestsFixed::~PipelineInterestsFixed() {
@@ -52,7 +55,9 @@ void PipelineInterestsFixed::open() {
 
     while (!isClosed()) {
         face->loop();
+        onVerifiedData();
         onTimeout();
+        updateGauges(m_windowSize);
 
         if (m_pit->size() >= m_windowSize) {
             continue; // Wait for data packets
@@ -102,10 +107,10 @@ void PipelineInterestsFixed::onData(std::shared_ptr<ndn::Data> &&data,
         return;
     }
 
-    m_counters.delay += it->second.getTimeSinceExpressed();
+    m_counters.recordDelay(it->second.getNanosecondsSinceExpressed());
 
-    // Enqueue Data into the response queue
-    if (!pushData(it->second.getConsumerId(), std::move(data))) {
+    // Enqueue Data into the response queue, once verified if enabled
+    if (!deliverData(it->second, std::move(data))) {
         this->close();
         return;
     }
@@ -33,7 +33,9 @@
 namespace ndnc {
 class PipelineInterestsFixed : public PipelineInterests {
   public:
-    PipelineInterestsFixed(face::Face &face, size_t windowSize);
+    PipelineInterestsFixed(face::Face &face, size_t windowSize,
+                           size_t verifyThreads = 0,
+                           size_t maxPendingInterests = 65536);
     ~PipelineInterestsFixed();
 
   private:
@@ -28,14 +28,20 @@
 #ifndef NDNC_CONGESTION_CONTROL_PIPELINE_INTERESTS_HPP
 #define NDNC_CONGESTION_CONTROL_PIPELINE_INTERESTS_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <queue>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "concurrentqueue/lightweightsemaphore.h"
+#include "data-verifier.hpp"
 #include "face/packet-handler.hpp"
 #include "pending-interest.hpp"
 #include "pipeline-type.hpp"
+#include "telemetry/registry.hpp"
+#include "utils/metrics.hpp"
 #include "utils/threadsafe-uint64-generator.hpp"
 
 namespace ndnc {
@@ -46,12 +52,50 @@ struct PipelineCounters {
     uint64_t tx = 0;
     uint64_t rx = 0;
     uint64_t rxUnexpected = 0;
+    uint64_t verifyFailed = 0;
 
     ndn::time::milliseconds getAverageDelay() {
         return ndn::time::milliseconds{rx > 0 ? delay.count() / rx : 0};
     }
 };
 
+/**
+ * @brief Live pipeline counters. They are written by the pipeline worker only
+ * and may be read at any time, e.g. by the metrics exporter
+ *
+ */
+struct PipelineMetrics {
+    metrics::Counter nack;
+    metrics::Counter timeout;
+    metrics::Counter tx;
+    metrics::Counter rx;
+    metrics::Counter rxUnexpected;
+    metrics::Counter verifyFailed;
+    metrics::Counter delayNs;
+    metrics::Gauge windowSize;
+    metrics::Gauge pitEntries;
+    // Round-trip time of satisfied Interests, in nanoseconds
+    metrics::AtomicHistogram rtt;
+
+    void recordDelay(uint64_t ns) {
+        delayNs += ns;
+        rtt.record(ns);
+    }
+
+    PipelineCounters snapshot() const {
+        PipelineCounters counters;
+        counters.delay = ndn::time::duration_cast<ndn::time::milliseconds>(
+            ndn::time::nanoseconds{delayNs.get()});
+        counters.nack = nack.get();
+        counters.timeout = timeout.get();
+        counters.tx = tx.get();
+        counters.rx = rx.get();
+        counters.rxUnexpected = rxUnexpected.get();
+        counters.verifyFailed = verifyFailed.get();
+        return counters;
+    }
+};
+
 class PipelineInterests : public PacketHandler {
   private:
     using PendingInterestsOrder = std::queue<uint64_t>;
@@ -59,26 +103,44 @@ class PipelineInterests : public PacketHandler {
     using ResponseQueuesMap = std::unordered_map<uint64_t, ResponseQueue>;
 
   public:
-    explicit PipelineInterests(face::Face &face)
-        : PacketHandler(face), m_counters{}, m_closed{false} {
+    /**
+     * @param verifyThreads Threads verifying Data signatures before they are
+     * handed to consumers. Zero disables verification
+     * @param maxPendingInterests Credits shared by all consumers. Pushing an
+     * Interest takes a credit and blocks while there is none; the credit is
+     * returned once the consumer pops the Data packet or failure of the
+     * Interest, so a slow consumer cannot grow its response queue unbounded
+     */
+    explicit PipelineInterests(face::Face &face, size_t verifyThreads = 0,
+                               size_t maxPendingInterests = 65536)
+        : PacketHandler(face), m_closed{false},
+          m_credits{static_cast<moodycamel::LightweightSemaphore::ssize_t>(
+              std::max<size_t>(maxPendingInterests, 1))} {
 
         face.addOnDisconnectHandler([&]() { this->m_closed = true; });
 
+        if (verifyThreads > 0) {
+            m_verifier = std::make_unique<DataVerifier>(verifyThreads);
+        }
+
         m_pit = std::make_shared<PendingInterestsTable>();
         m_piq = std::make_shared<PendingInterestsOrder>();
         m_rdn = std::make_shared<ThreadSafeUInt64Generator>();
 
         registerConsumer(0);
+        registerMetrics();
         m_worker = std::thread(&PipelineInterests::open, this);
     }
 
     virtual ~PipelineInterests() {
+        telemetry::Registry::instance().remove(m_metricsHandle);
         this->close();
 
         if (m_worker.joinable()) {
             m_worker.join();
         }
 
+        m_verifier.reset();
         m_pit->clear();
 
         while (!m_piq->empty()) {
@@ -97,7 +159,36 @@ class PipelineInterests : public PacketHandler {
     }
 
     PipelineCounters getCounters() {
-        return m_counters;
+        return m_counters.snapshot();
+    }
+
+    /**
+     * @brief Register the validator of a signature type
+     *
+     * @return false if verification is disabled
+     */
+    bool setValidator(uint32_t signatureType,
+                      DataVerifier::Validator validator) {
+        if (m_verifier == nullptr) {
+            return false;
+        }
+
+        m_verifier->setValidator(signatureType, validator);
+        return true;
+    }
+
+    /**
+     * @brief Accept Data packets whose signature type has no validator
+     *
+     * @return false if verification is disabled
+     */
+    bool setAcceptUnknownSignatureTypes(bool accept) {
+        if (m_verifier == nullptr) {
+            return false;
+        }
+
+        m_verifier->setAcceptUnknownSignatureTypes(accept);
+        return true;
     }
 
     uint64_t getQueuedInterestsCount() {
@@ -116,7 +207,21 @@ class PipelineInterests : public PacketHandler {
 
     void unregisterConsumer(const uint64_t consumerId) {
         std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
-        responseQueuesMap_.erase(consumerId);
+
+        auto it = responseQueuesMap_.find(consumerId);
+        if (it == responseQueuesMap_.end()) {
+            return;
+        }
+
+        // Return the credits of the responses that were never popped
+        std::shared_ptr<ndn::Data> pkt;
+        size_t n = 0;
+        while (it->second.try_dequeue(pkt)) {
+            ++n;
+        }
+        releaseCredits(n);
+
+        responseQueuesMap_.erase(it);
     }
 
     bool pushInterest(uint64_t consumerId,
@@ -139,10 +244,19 @@ class PipelineInterests : public PacketHandler {
             }
         }
 
+        if (acquireCredits(1) == 0) {
+            return false;
+        }
+
         auto newPendingInterest =
             PendingInterest(std::move(pkt), m_rdn->generate(), consumerId);
 
-        return m_requestQueue.enqueue(std::move(newPendingInterest));
+        if (!m_requestQueue.enqueue(std::move(newPendingInterest))) {
+            releaseCredits(1);
+            return false;
+        }
+
+        return true;
     }
 
     bool pushInterestBulk(uint64_t consumerId,
@@ -174,8 +288,84 @@ class PipelineInterests : public PacketHandler {
             newPendingInterests.emplace_back(std::move(newPendingInterest));
         }
 
-        return m_requestQueue.enqueue_bulk(newPendingInterests.begin(),
-                                           newPendingInterests.size());
+        // Enqueue as credits become available; a batch larger than the
+        // credit pool is not an error
+        for (size_t offset = 0; offset < newPendingInterests.size();) {
+            auto n = acquireCredits(newPendingInterests.size() - offset);
+            if (n == 0) {
+                return false;
+            }
+
+            if (!m_requestQueue.enqueue_bulk(
+                    std::make_move_iterator(newPendingInterests.begin() +
+                                            offset),
+                    n)) {
+                releaseCredits(n);
+                return false;
+            }
+
+            offset += n;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Push Interests from offset onwards for as many credits as are
+     * available, without waiting. Lets a thread that pops its own responses
+     * interleave pushing and popping instead of blocking on credits held by
+     * its unpopped Data
+     *
+     * @param offset Index of the first Interest to push, advanced past the
+     * pushed ones
+     * @return false if the pipeline is closed or on error
+     */
+    bool tryPushInterestBulk(uint64_t consumerId,
+                             std::vector<std::shared_ptr<ndn::Interest>> &pkts,
+                             size_t &offset) {
+        // Do nothing if the pipeline is already closed
+        if (isClosed()) {
+            LOG_INFO("pipeline is closed (try push interest bulk)");
+            return false;
+        }
+
+        if (offset >= pkts.size()) {
+            return true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
+            if (responseQueuesMap_.find(consumerId) ==
+                responseQueuesMap_.end()) {
+                LOG_ERROR("unable to push interest pkts. reason: unregistered "
+                          "consumer id=%ld",
+                          consumerId);
+                close();
+                return false;
+            }
+        }
+
+        auto n = static_cast<size_t>(m_credits.tryWaitMany(
+            static_cast<moodycamel::LightweightSemaphore::ssize_t>(
+                pkts.size() - offset)));
+
+        std::vector<PendingInterest> newPendingInterests;
+        newPendingInterests.reserve(n);
+
+        for (size_t i = offset; i < offset + n; ++i) {
+            newPendingInterests.emplace_back(std::move(pkts[i]),
+                                             m_rdn->generate(), consumerId);
+        }
+
+        if (n > 0 && !m_requestQueue.enqueue_bulk(
+                         std::make_move_iterator(newPendingInterests.begin()),
+                         n)) {
+            releaseCredits(n);
+            return false;
+        }
+
+        offset += n;
+        return true;
     }
 
     bool popData(uint64_t consumerId, std::shared_ptr<ndn::Data> &pkt) {
@@ -188,7 +378,13 @@ class PipelineInterests : public PacketHandler {
         std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
 
         try {
-            return responseQueuesMap_.at(consumerId).try_dequeue(pkt);
+            if (!responseQueuesMap_.at(consumerId).try_dequeue(pkt)) {
+                return false;
+            }
+
+            releaseCredits(1);
+            telemetry::Tracer::instance().onPickup(pkt.get());
+            return true;
         } catch (const std::out_of_range &oor) {
             LOG_ERROR("out of range error (pop data): %s for consumer id: %ld",
                       oor.what(), consumerId);
@@ -208,8 +404,15 @@ class PipelineInterests : public PacketHandler {
         std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
 
         try {
-            return responseQueuesMap_.at(consumerId)
-                .try_dequeue_bulk(pkts.begin(), pkts.size());
+            auto n = responseQueuesMap_.at(consumerId)
+                         .try_dequeue_bulk(pkts.begin(), pkts.size());
+            releaseCredits(n);
+
+            for (size_t i = 0; i < n; ++i) {
+                telemetry::Tracer::instance().onPickup(pkts[i].get());
+            }
+
+            return n;
         } catch (const std::out_of_range &oor) {
             LOG_ERROR("out of range error (pop data bulk): %s for consumer "
                       "id: %ld",
@@ -220,24 +423,116 @@ class PipelineInterests : public PacketHandler {
     }
 
   protected:
-    bool pushData(uint64_t consumerId, std::shared_ptr<ndn::Data> &&pkt) {
+    /**
+     * @brief Hand the outcome of an Interest to its consumer: a Data packet
+     * or nullptr on failure. The credit taken by the Interest is returned
+     * when the consumer pops it
+     *
+     * @param span The trace span of a sampled Interest, completed once the
+     * consumer pops the Data packet
+     */
+    bool pushData(uint64_t consumerId, std::shared_ptr<ndn::Data> &&pkt,
+                  std::shared_ptr<telemetry::TraceSpan> span = nullptr) {
         if (isClosed()) {
             LOG_INFO("pipeline is closed (push data)");
             return false;
         }
 
+        // Before the enqueue, the consumer may pop the packet right away
+        if (span != nullptr && pkt != nullptr) {
+            telemetry::Tracer::instance().awaitPickup(pkt.get(),
+                                                      std::move(span));
+        }
+
         std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
 
         try {
-            return responseQueuesMap_.at(consumerId).enqueue(std::move(pkt));
+            if (!responseQueuesMap_.at(consumerId).enqueue(std::move(pkt))) {
+                releaseCredits(1);
+                return false;
+            }
+            return true;
         } catch (const std::out_of_range &oor) {
             LOG_ERROR("out of range error (push data): %s for consumer id: %ld",
                       oor.what(), consumerId);
+            releaseCredits(1);
             close();
             return false;
         }
     }
 
+    /**
+     * @brief Hand a Data packet to its consumer, through the verification
+     * stage when enabled
+     *
+     */
+    bool deliverData(const PendingInterest &pendingInterest,
+                     std::shared_ptr<ndn::Data> &&pkt) {
+        auto &span = pendingInterest.getTraceSpan();
+        if (span != nullptr) {
+            span->mark(telemetry::TraceSpan::rx);
+        }
+
+        if (m_verifier == nullptr) {
+            auto consumerId = pendingInterest.getConsumerId();
+            return pushData(consumerId, std::move(pkt), span);
+        }
+
+        return m_verifier->submit(
+            VerifyRequest{std::move(pkt), pendingInterest, false});
+    }
+
+    /**
+     * @brief Hand verified Data packets to their consumers and express again
+     * the Interests of packets that failed verification
+     *
+     */
+    void onVerifiedData() {
+        if (m_verifier == nullptr) {
+            return;
+        }
+
+        m_verified.clear();
+        if (m_verifier->poll(m_verified) == 0) {
+            return;
+        }
+
+        for (auto &request : m_verified) {
+            auto consumerId = request.pendingInterest.getConsumerId();
+
+            if (request.ok) {
+                if (!pushData(consumerId, std::move(request.data),
+                              request.pendingInterest.getTraceSpan())) {
+                    close();
+                    return;
+                }
+                continue;
+            }
+
+            ++m_counters.verifyFailed;
+            LOG_DEBUG("verification failed for %s",
+                      request.data->getName().toUri().c_str());
+
+            if (request.pendingInterest.hasReachedMaximumNumOfRetries()) {
+                LOG_FATAL("reached maximum number of retries on verification "
+                          "failures");
+
+                // Enqueue null to mark error
+                if (!pushData(consumerId, nullptr)) {
+                    close();
+                    return;
+                }
+                continue;
+            }
+
+            request.pendingInterest.refresh(m_rdn->generate(), true);
+            if (!m_requestQueue.enqueue(std::move(request.pendingInterest))) {
+                close();
+                return;
+            }
+        }
+    }
+
     size_t popPendingInterests(std::vector<PendingInterest> &pendingInterests,
                                size_t n) {
         if (isClosed()) {
@@ -248,7 +543,17 @@ class PipelineInterests : public PacketHandler {
         pendingInterests.clear();
         pendingInterests.reserve(n);
 
-        return m_requestQueue.try_dequeue_bulk(pendingInterests.begin(), n);
+        auto size =
+            m_requestQueue.try_dequeue_bulk(pendingInterests.begin(), n);
+
+        for (size_t i = 0; i < size; ++i) {
+            auto &span = pendingInterests[i].getTraceSpan();
+            if (span != nullptr) {
+                span->mark(telemetry::TraceSpan::dequeued);
+            }
+        }
+
+        return size;
     }
 
     bool refreshPITEntry(uint64_t key, bool timeoutReason = false) {
@@ -272,7 +577,104 @@ class PipelineInterests : public PacketHandler {
         return true;
     }
 
+    /**
+     * @brief Publish the window and PIT occupancy; called by the worker
+     *
+     */
+    void updateGauges(size_t windowSize) {
+        m_counters.windowSize.set(static_cast<int64_t>(windowSize));
+        m_counters.pitEntries.set(static_cast<int64_t>(m_pit->size()));
+    }
+
   private:
+    /**
+     * @brief Expose the counters and queue depths through the metrics
+     * registry. The collector only reads atomics, except for the response
+     * queues map which is briefly locked
+     *
+     */
+    void registerMetrics() {
+        auto id = std::to_string(
+            telemetry::Registry::instance().nextInstanceId());
+
+        m_metricsHandle = telemetry::Registry::instance().add(
+            [this, id](telemetry::MetricsWriter &writer) {
+                telemetry::MetricsWriter::Labels labels{{"pipeline", id}};
+
+                writer.counter("ndnc_pipeline_tx_interests",
+                               "Interest packets sent", labels,
+                               m_counters.tx.get());
+                writer.counter("ndnc_pipeline_rx_data",
+                               "Data packets received", labels,
+                               m_counters.rx.get());
+                writer.counter("ndnc_pipeline_rx_unexpected",
+                               "Packets received without a PIT entry",
+                               labels, m_counters.rxUnexpected.get());
+                writer.counter("ndnc_pipeline_rx_nacks",
+                               "Nack packets received", labels,
+                               m_counters.nack.get());
+                writer.counter("ndnc_pipeline_timeouts", "Interest timeouts",
+                               labels, m_counters.timeout.get());
+                writer.counter("ndnc_pipeline_verify_failed",
+                               "Data packets that failed verification",
+                               labels, m_counters.verifyFailed.get());
+
+                writer.gauge("ndnc_pipeline_window_size",
+                             "Congestion window size", labels,
+                             m_counters.windowSize.get());
+                writer.gauge("ndnc_pipeline_pit_entries",
+                             "Interests expressed and not yet satisfied",
+                             labels, m_counters.pitEntries.get());
+                writer.gauge("ndnc_pipeline_request_queue_depth",
+                             "Interests waiting to be expressed", labels,
+                             m_requestQueue.size_approx());
+                writer.gauge("ndnc_pipeline_credits_available",
+                             "Interests that can be pushed without blocking",
+                             labels, m_credits.availableApprox());
+
+                writer.histogram("ndnc_pipeline_rtt_seconds",
+                                 "Round-trip time of satisfied Interests",
+                                 labels, m_counters.rtt.snapshot(), 1e-9,
+                                 m_counters.delayNs.get());
+
+                std::lock_guard<std::mutex> lock(m_responseQueuesMtx);
+                for (auto &entry : responseQueuesMap_) {
+                    writer.gauge("ndnc_pipeline_response_queue_depth",
+                                 "Data packets waiting to be consumed",
+                                 {{"pipeline", id},
+                                  {"consumer", std::to_string(entry.first)}},
+                                 entry.second.size_approx());
+                }
+            });
+    }
+
+    /**
+     * @brief Take up to n credits, waiting for at least one
+     *
+     * @return size_t The number of credits taken, 0 if the pipeline closed
+     */
+    size_t acquireCredits(size_t n) {
+        while (!isClosed()) {
+            auto acquired = m_credits.waitMany(
+                static_cast<moodycamel::LightweightSemaphore::ssize_t>(n),
+                10000);
+
+            if (acquired > 0) {
+                return static_cast<size_t>(acquired);
+            }
+        }
+
+        LOG_INFO("pipeline is closed (acquire credits)");
+        return 0;
+    }
+
+    void releaseCredits(size_t n) {
+        if (n > 0) {
+            m_credits.signal(
+                static_cast<moodycamel::LightweightSemaphore::ssize_t>(n));
+        }
+    }
+
     virtual void open() = 0;
     virtual void onTimeout() = 0;
 
@@ -280,14 +682,19 @@ class PipelineInterests : public PacketHandler {
     std::shared_ptr<PendingInterestsTable> m_pit;
     std::shared_ptr<PendingInterestsOrder> m_piq;
     std::shared_ptr<ThreadSafeUInt64Generator> m_rdn;
-    PipelineCounters m_counters;
+    PipelineMetrics m_counters;
 
   private:
     RequestQueue m_requestQueue;
     ResponseQueuesMap responseQueuesMap_;
 
+    std::unique_ptr<DataVerifier> m_verifier;
+    std::vector<VerifyRequest> m_verified;
+
     std::mutex m_responseQueuesMtx;
     std::atomic_bool m_closed;
+    moodycamel::LightweightSemaphore m_credits;
+    uint64_t m_metricsHandle;
     std::thread m_worker;
 };
 }; // namespace ndnc
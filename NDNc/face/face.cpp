@@ -27,15 +27,23 @@
 
 #include "face.hpp"
 #include "logger/logger.hpp"
+#include "telemetry/registry.hpp"
 
 namespace ndnc {
 namespace face {
 Face::Face()
     : m_transport{nullptr}, m_packetHandler{nullptr}, m_hasError{false} {
     m_gqlClient = std::make_shared<mgmt::Client>();
+    registerMetrics();
 }
 
 Face::~Face() {
+    telemetry::Registry::instance().remove(m_metricsHandle);
+
+    if (isConnected()) {
+        flush();
+    }
+
     if (m_gqlClient != nullptr) {
         m_gqlClient->deleteFace();
     }
@@ -83,7 +91,11 @@ void Face::disconnect() {
 }
 
 bool Face::loop() {
-    return m_transport->loop();
+    auto ok = m_transport->loop();
+
+    // End of the RX burst
+    flush();
+    return ok;
 }
 
 bool Face::addPacketHandler(PacketHandler &h) {
@@ -113,11 +125,84 @@ bool Face::advertise(const std::string prefix) {
 }
 
 int Face::send(const ndn::Block pkt) {
-    return m_transport->send(pkt);
+    if (m_txQueue.size() >= MAX_MEMIF_TX_BUFS) {
+        if (flush() < 0) {
+            return -1;
+        }
+
+        // The transport has not accepted the previous burst yet
+        if (m_txQueue.size() >= MAX_MEMIF_TX_BUFS) {
+            return -1;
+        }
+    }
+
+    if (m_txQueue.empty()) {
+        m_txQueue.reserve(MAX_MEMIF_TX_BUFS);
+    }
+
+    m_txQueue.push_back(pkt);
+    m_counters.txQueue.set(static_cast<int64_t>(m_txQueue.size()));
+
+    if (m_txQueue.size() >= MAX_MEMIF_TX_BUFS) {
+        return flush() < 0 ? -1 : 1;
+    }
+
+    return 1;
 }
 
 int Face::send(const std::vector<ndn::Block> *pkts, uint16_t n) {
-    return m_transport->send(pkts, n);
+    // Keep packets in order
+    if (flush() < 0) {
+        return -1;
+    }
+
+    if (!m_txQueue.empty()) {
+        return 0;
+    }
+
+    // The caller does not keep the packets the transport did not accept
+    auto tx = transmit(pkts, n);
+    if (tx >= 0) {
+        m_counters.txDropped += n - tx;
+    }
+
+    return tx;
+}
+
+int Face::flush() {
+    if (m_txQueue.empty()) {
+        return 0;
+    }
+
+    auto n = m_txQueue.size();
+    auto tx = transmit(&m_txQueue, n);
+
+    if (tx < 0) {
+        m_counters.txDropped += n;
+        m_txQueue.clear();
+        m_counters.txQueue.set(0);
+        return tx;
+    }
+
+    // Keep the packets the transport did not accept for the next flush
+    if (static_cast<size_t>(tx) < n) {
+        LOG_DEBUG("face flush sent=%d queued=%zu", tx, n - tx);
+    }
+
+    m_txQueue.erase(m_txQueue.begin(), m_txQueue.begin() + tx);
+    m_counters.txQueue.set(static_cast<int64_t>(m_txQueue.size()));
+    return tx;
+}
+
+int Face::transmit(const std::vector<ndn::Block> *pkts, uint16_t n) {
+    auto tx = m_transport->send(pkts, n);
+
+    ++m_counters.txBursts;
+    if (tx >= 0) {
+        m_counters.txPackets += tx;
+    }
+
+    return tx;
 }
 
 void Face::receive(const ndn::Block &&pkt) {
@@ -132,10 +217,12 @@ void Face::receive(const ndn::Block &&pkt) {
             ndn::lp::PitToken(lpPacket.get<ndn::lp::PitTokenField>());
 
         if (lpPacket.has<ndn::lp::NackField>()) {
+            ++m_counters.rxNacks;
             m_packetHandler->onNack(
                 std::make_shared<ndn::lp::Nack>(std::move(*interest)),
                 std::move(pitToken));
         } else {
+            ++m_counters.rxInterests;
             m_packetHandler->onInterest(std::move(interest),
                                         std::move(pitToken));
         }
@@ -143,6 +230,7 @@ void Face::receive(const ndn::Block &&pkt) {
     }
 
     case ndn::tlv::Data: {
+        ++m_counters.rxData;
         m_packetHandler->onData(
             std::make_shared<ndn::Data>(netPacket),
             ndn::lp::PitToken(lpPacket.get<ndn::lp::PitTokenField>()));
@@ -151,10 +239,41 @@ void Face::receive(const ndn::Block &&pkt) {
     }
 
     default: {
+        ++m_counters.rxOther;
         LOG_WARN("received unexpected packet type=%i", netPacket.type());
         return;
     }
     }
 }
+
+void Face::registerMetrics() {
+    auto id = std::to_string(telemetry::Registry::instance().nextInstanceId());
+
+    m_metricsHandle = telemetry::Registry::instance().add(
+        [this, id](telemetry::MetricsWriter &writer) {
+            telemetry::MetricsWriter::Labels labels{{"face", id}};
+
+            writer.counter("ndnc_face_rx_interests",
+                           "Interest packets received", labels,
+                           m_counters.rxInterests.get());
+            writer.counter("ndnc_face_rx_data", "Data packets received",
+                           labels, m_counters.rxData.get());
+            writer.counter("ndnc_face_rx_nacks", "Nack packets received",
+                           labels, m_counters.rxNacks.get());
+            writer.counter("ndnc_face_rx_other",
+                           "Packets of unexpected type received", labels,
+                           m_counters.rxOther.get());
+            writer.counter("ndnc_face_tx_packets", "Packets transmitted",
+                           labels, m_counters.txPackets.get());
+            writer.counter("ndnc_face_tx_dropped",
+                           "Packets discarded without transmission", labels,
+                           m_counters.txDropped.get());
+            writer.counter("ndnc_face_tx_bursts", "Transmitted bursts",
+                           labels, m_counters.txBursts.get());
+            writer.gauge("ndnc_face_tx_queue_depth",
+                         "Packets queued for the next burst", labels,
+                         m_counters.txQueue.get());
+        });
+}
 }; // namespace face
 }; // namespace ndnc
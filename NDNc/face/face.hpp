@@ -30,21 +30,42 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 #if (!defined(__APPLE__) && !defined(__MACH__))
 #include "memif.hpp"
 #else
 #include "transport.hpp"
 #endif
 #include "mgmt/client.hpp"
+#include "utils/metrics.hpp"
 
 namespace ndnc {
 class PacketHandler;
+namespace bench {
+class FaceAccess;
+};
 };
 #include "packet-handler.hpp"
 
 namespace ndnc {
 namespace face {
 class Face {
+    // Drives receive() from the microbenchmarks
+    friend class ndnc::bench::FaceAccess;
+
+  private:
+    // Written by the thread running the face loop only
+    struct Counters {
+        metrics::Counter rxInterests;
+        metrics::Counter rxData;
+        metrics::Counter rxNacks;
+        metrics::Counter rxOther;
+        metrics::Counter txPackets;
+        metrics::Counter txDropped;
+        metrics::Counter txBursts;
+        metrics::Gauge txQueue;
+    };
+
   public:
     Face();
     ~Face();
@@ -53,11 +74,40 @@ class Face {
     bool isConnected();
     void disconnect();
 
+    /**
+     * @brief Poll the transport for received packets and flush the packets
+     * queued for transmission while handling them. Packets queued by send()
+     * wait at most until the end of the current loop() call
+     *
+     */
     bool loop();
 
+    /**
+     * @brief Queue a packet for transmission. Queued packets are sent in one
+     * burst at the end of loop() or as soon as the burst is full
+     *
+     * @return int 1 if queued, -1 if the queue is full because the transport
+     * does not accept packets or on error
+     */
     int send(const ndn::Block pkt);
+
+    /**
+     * @brief Send a burst of packets right away, after any queued packets.
+     * Packets the transport does not accept are counted as dropped
+     *
+     * @return int The number of packets sent, 0 while queued packets are
+     * still waiting for the transport, or -1 on error
+     */
     int send(const std::vector<ndn::Block> *pkts, uint16_t n);
 
+    /**
+     * @brief Send the queued packets. Packets the transport does not accept
+     * stay queued, in order, for the next flush
+     *
+     * @return int The number of packets sent or -1 on error
+     */
+    int flush();
+
     bool advertise(const std::string prefix);
 
     bool addPacketHandler(PacketHandler &h);
@@ -65,20 +115,30 @@ class Face {
 
   private:
     /**
-     * @brief Handle peer interupts - packets arrival
+     * @brief Handle peer interupts - packets arrival. Decodes the LpPacket
+     * and dispatches it to the packet handler
      *
      * @param pkt Received packet over memif face
-     * @param len Size of received packet
      */
     void receive(const ndn::Block &&pkt);
 
+    int transmit(const std::vector<ndn::Block> *pkts, uint16_t n);
+
+    void registerMetrics();
+
   private:
     std::shared_ptr<transport::Transport> m_transport;
     std::shared_ptr<mgmt::Client> m_gqlClient;
 
     PacketHandler *m_packetHandler;
     bool m_hasError;
+
+    std::vector<ndn::Block> m_txQueue;
+
     std::function<void()> onDisconnect = nullptr;
+
+    Counters m_counters;
+    uint64_t m_metricsHandle;
 };
 }; // namespace face
 }; // namespace ndnc
@@ -25,22 +25,62 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <list>
+#include <thread>
+
 #include "consumer.hpp"
 #include "logger/logger.hpp"
+#include "telemetry/http-exporter.hpp"
+#include "telemetry/registry.hpp"
+#include "telemetry/tracer.hpp"
 
 namespace ndnc::posix {
 Consumer::Consumer(ConsumerOptions options)
-    : options_{options}, face_{nullptr}, pipeline_{nullptr}, is_valid_{false},
-      error_{false} {
+    : options_{options}, face_{nullptr}, pipeline_{nullptr},
+      metadataCache_{options.metadataCacheTTL,
+                     options.metadataNegativeCacheTTL},
+      metadataLookups_{}, reporter_{nullptr}, is_valid_{false}, error_{false},
+      stop_{false} {
+    if (options_.traceSampling > 0) {
+        telemetry::Tracer::instance().start(options_.traceSampling);
+    }
+
     this->openFace();
     this->openPipeline();
+    this->registerMetrics();
+    this->openReporter();
+
+    if (!options_.metricsAddress.empty()) {
+        telemetry::HttpExporter::instance().start(options_.metricsAddress);
+    }
 }
 
 Consumer::~Consumer() {
+    telemetry::Registry::instance().remove(metricsHandle_);
+    // The sampler reads the pipeline counters, stop it first
+    reporter_.reset();
     this->stop();
+
+    if (options_.traceSampling > 0) {
+        telemetry::Tracer::instance().stop();
+        telemetry::Tracer::instance().logSummary();
+
+        if (!options_.traceFile.empty()) {
+            telemetry::Tracer::instance().writeChromeTrace(options_.traceFile);
+        }
+    }
 }
 
 void Consumer::stop() {
+    stop_ = true;
+
+    if (asyncWorker_.joinable()) {
+        asyncWorker_.join();
+    }
+
     if (pipeline_ != nullptr && !pipeline_->isClosed()) {
         pipeline_->close();
     }
@@ -68,13 +108,18 @@ void Consumer::openPipeline() {
     switch (options_.pipelineType) {
     case ndnc::PipelineType::aimd:
         this->pipeline_ = std::make_shared<ndnc::PipelineInterestsAimd>(
-            *face_, options_.pipelineSize);
+            *face_, options_.pipelineSize, options_.verifyThreads,
+            options_.maxPendingInterests);
         break;
     case ndnc::PipelineType::fixed:
     default:
         this->pipeline_ = std::make_shared<ndnc::PipelineInterestsFixed>(
-            *face_, options_.pipelineSize);
+            *face_, options_.pipelineSize, options_.verifyThreads,
+            options_.maxPendingInterests);
     }
+
+    pipeline_->setAcceptUnknownSignatureTypes(
+        options_.acceptUnknownSignatureTypes);
 }
 
 uint64_t Consumer::registerConsumer() {
@@ -112,18 +157,21 @@ std::vector<std::shared_ptr<ndn::Data>> Consumer::syncRequestDataFor(
         interest->setInterestLifetime(options_.interestLifetime);
     }
 
-    if (!pipeline_->pushInterestBulk(id, std::move(interests))) {
-        LOG_FATAL("unable to push Interest packets to pipeline");
-        error_ = true;
-        return {};
-    }
-
     std::vector<std::shared_ptr<ndn::Data>> pkts;
+    size_t pushed = 0;
 
     for (; npkts > 0; --npkts) {
         std::shared_ptr<ndn::Data> pkt(nullptr);
 
-        while (this->isValid() && !pipeline_->popData(id, pkt)) {}
+        // Unpopped responses hold their credits, push only as many Interests
+        // as there are credits and keep popping
+        do {
+            if (!pipeline_->tryPushInterestBulk(id, interests, pushed)) {
+                LOG_FATAL("unable to push Interest packets to pipeline");
+                error_ = true;
+                return {};
+            }
+        } while (this->isValid() && !pipeline_->popData(id, pkt));
 
         if (pkt == nullptr) {
             return {};
@@ -169,11 +217,232 @@ bool Consumer::asyncRequestDataFor(
     return true;
 }
 
+bool Consumer::syncRequestDataFor(
+    std::vector<std::shared_ptr<ndn::Interest>> &&interests, uint64_t id,
+    OnData onData) {
+    auto npkts = interests.size();
+
+    for (auto interest : interests) {
+        interest->setInterestLifetime(options_.interestLifetime);
+    }
+
+    bool ok = true;
+    std::vector<std::shared_ptr<ndn::Data>> pkts;
+    size_t pushed = 0;
+
+    while (npkts > 0 && this->isValid()) {
+        // Unpopped responses hold their credits, push only as many Interests
+        // as there are credits and keep popping
+        if (!pipeline_->tryPushInterestBulk(id, interests, pushed)) {
+            LOG_FATAL("unable to push Interest packets to pipeline");
+            error_ = true;
+            return false;
+        }
+
+        pkts.resize(std::min<size_t>(npkts, 64));
+
+        auto n = pipeline_->popDataBulk(id, pkts);
+        for (size_t i = 0; i < n && ok; ++i) {
+            ok = pkts[i] != nullptr && onData(*pkts[i]);
+        }
+
+        npkts -= n;
+    }
+
+    return ok && npkts == 0;
+}
+
+bool Consumer::asyncRequestDataFor(
+    std::vector<std::shared_ptr<ndn::Interest>> &&interests, OnData onData,
+    OnRequestCompleted onCompleted) {
+    std::call_once(asyncWorkerFlag_, [this]() {
+        asyncWorker_ = std::thread(&Consumer::completeAsyncRequests, this);
+    });
+
+    for (auto interest : interests) {
+        interest->setInterestLifetime(options_.interestLifetime);
+    }
+
+    AsyncRequest request;
+    request.id = registerConsumer();
+    request.expected = interests.size();
+    request.interests = std::move(interests);
+    request.onData = std::move(onData);
+    request.onCompleted = std::move(onCompleted);
+
+    // The completion thread pushes the Interests interleaved with popping
+    // their responses, since unpopped responses hold their credits
+    auto id = request.id;
+    if (!asyncRequests_.enqueue(std::move(request))) {
+        unregisterConsumer(id);
+        return false;
+    }
+
+    return true;
+}
+
+void Consumer::completeAsyncRequests() {
+    std::list<AsyncRequest> pending;
+    std::vector<std::shared_ptr<ndn::Data>> pkts(64);
+    // Idle wait while no Data is ready, doubled up to 1ms so the thread does
+    // not spin a core for the network round trip
+    std::chrono::microseconds backoff{0};
+
+    auto fail = [](AsyncRequest &request) {
+        if (!request.failed) {
+            // Report the error now, stop pushing and drain the responses of
+            // the pushed Interests before releasing the consumer id
+            request.failed = true;
+            request.expected = request.pushed;
+            request.onCompleted(false);
+        }
+    };
+
+    while (!stop_) {
+        AsyncRequest request;
+
+        if (pending.empty()) {
+            if (asyncRequests_.wait_dequeue_timed(
+                    request, std::chrono::milliseconds(100))) {
+                pending.emplace_back(std::move(request));
+            }
+            continue;
+        }
+
+        while (asyncRequests_.try_dequeue(request)) {
+            pending.emplace_back(std::move(request));
+        }
+
+        if (!isValid()) {
+            break;
+        }
+
+        bool progress = false;
+
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (!it->failed && it->pushed < it->interests.size()) {
+                auto pushed = it->pushed;
+
+                if (!pipeline_->tryPushInterestBulk(it->id, it->interests,
+                                                    it->pushed)) {
+                    LOG_ERROR("unable to push Interest packets to pipeline");
+                    fail(*it);
+                }
+                progress |= it->pushed > pushed;
+            }
+
+            auto n = pipeline_->popDataBulk(it->id, pkts);
+            progress |= n > 0;
+
+            for (size_t i = 0; i < n && !it->failed; ++i) {
+                if (pkts[i] == nullptr || !it->onData(*pkts[i])) {
+                    fail(*it);
+                }
+            }
+            it->received += n;
+
+            if (it->received < it->expected) {
+                ++it;
+                continue;
+            }
+
+            if (!it->failed) {
+                it->onCompleted(true);
+            }
+
+            unregisterConsumer(it->id);
+            it = pending.erase(it);
+        }
+
+        if (progress) {
+            backoff = std::chrono::microseconds{0};
+            continue;
+        }
+
+        backoff = std::min(std::max(backoff * 2, std::chrono::microseconds{10}),
+                           std::chrono::microseconds{1000});
+        std::this_thread::sleep_for(backoff);
+    }
+
+    // Fail all outstanding requests
+    AsyncRequest request;
+    while (asyncRequests_.try_dequeue(request)) {
+        pending.emplace_back(std::move(request));
+    }
+
+    for (auto &request : pending) {
+        fail(request);
+        unregisterConsumer(request.id);
+    }
+}
+
+bool Consumer::tryRequestDataFor(
+    std::vector<std::shared_ptr<ndn::Interest>> &interests, size_t &offset,
+    uint64_t id) {
+    for (auto i = offset; i < interests.size(); ++i) {
+        interests[i]->setInterestLifetime(options_.interestLifetime);
+    }
+
+    if (!pipeline_->tryPushInterestBulk(id, interests, offset)) {
+        LOG_FATAL("unable to push Interest packets to pipeline");
+        error_ = true;
+        return false;
+    }
+
+    return true;
+}
+
 size_t Consumer::getData(std::vector<std::shared_ptr<ndn::Data>> &pkts,
                          uint64_t id) {
     return pipeline_->popDataBulk(id, pkts);
 }
 
+int Consumer::getFileMetadata(const std::string &path,
+                              std::shared_ptr<FileMetadata> &metadata) {
+    auto lookup = metadataCache_.find(path, metadata);
+    metadataLookups_[static_cast<size_t>(lookup)].fetch_add(
+        1, std::memory_order_relaxed);
+
+    switch (lookup) {
+    case MetadataCache::Lookup::hit:
+        return 0;
+    case MetadataCache::Lookup::negative:
+        return -ENOENT;
+    case MetadataCache::Lookup::miss:
+    default:
+        break;
+    }
+
+    auto interest = std::make_shared<ndn::Interest>(
+        rdrDiscoveryNameFileRetrieval(path, options_.prefix));
+    interest->setCanBePrefix(true);
+    interest->setMustBeFresh(true);
+
+    auto id = this->registerConsumer();
+    auto data = this->syncRequestDataFor(std::move(interest), id);
+    this->unregisterConsumer(id);
+
+    if (data == nullptr || !data->hasContent()) {
+        LOG_ERROR("metadata: invalid data for '%s'", path.c_str());
+        return -1;
+    }
+
+    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+        LOG_DEBUG("metadata: no such file or directory '%s'", path.c_str());
+        metadataCache_.insertNegative(path);
+        return -ENOENT;
+    }
+
+    metadata = std::make_shared<FileMetadata>(data->getContent());
+    metadataCache_.insert(path, metadata);
+    return 0;
+}
+
+bool Consumer::setDataValidator(uint32_t signatureType,
+                                ndnc::DataVerifier::Validator validator) {
+    return pipeline_->setValidator(signatureType, validator);
+}
+
 ndn::Name Consumer::getNamePrefix() {
     return options_.prefix;
 }
@@ -185,4 +454,47 @@ ndnc::PipelineCounters Consumer::getCounters() {
 ConsumerOptions Consumer::getOptions() {
     return this->options_;
 }
+
+void Consumer::recordRead(size_t bytes, std::chrono::nanoseconds latency) {
+    if (reporter_ != nullptr) {
+        reporter_->record(bytes, latency);
+    }
+}
+
+void Consumer::openReporter() {
+    if (options_.influxdb.empty() || pipeline_ == nullptr) {
+        return;
+    }
+
+    reporter_ =
+        std::make_unique<ndnc::MeasurementsReporter>(16, options_.to_string());
+    reporter_->init("xrd", options_.influxdb, [this]() {
+        auto counters = pipeline_->getCounters();
+        return ndnc::MeasurementsReporter::Sample{
+            static_cast<int64_t>(counters.tx),
+            static_cast<int64_t>(counters.rx),
+            counters.getAverageDelay().count()};
+    });
+}
+
+void Consumer::registerMetrics() {
+    auto id = std::to_string(telemetry::Registry::instance().nextInstanceId());
+
+    metricsHandle_ = telemetry::Registry::instance().add(
+        [this, id](telemetry::MetricsWriter &writer) {
+            static const char *results[] = {"miss", "hit", "negative"};
+
+            for (size_t i = 0; i < metadataLookups_.size(); ++i) {
+                writer.counter(
+                    "ndnc_consumer_metadata_lookups",
+                    "Metadata cache lookups by result",
+                    {{"consumer", id}, {"result", results[i]}},
+                    metadataLookups_[i].load(std::memory_order_relaxed));
+            }
+
+            writer.gauge("ndnc_consumer_async_requests_queued",
+                         "Asynchronous requests waiting for completion",
+                         {{"consumer", id}}, asyncRequests_.size_approx());
+        });
+}
 } // namespace ndnc::posix
@@ -28,6 +28,9 @@
 #ifndef NDNC_LIB_POSIX_CONSUMER_HPP
 #define NDNC_LIB_POSIX_CONSUMER_HPP
 
+#include <array>
+#include <functional>
+#include <mutex>
 #include <vector>
 
 #include <ndn-cxx/data.hpp>
@@ -37,6 +40,8 @@
 
 #include "congestion-control/pipeline-interests-aimd.hpp"
 #include "congestion-control/pipeline-interests-fixed.hpp"
+#include "metadata-cache.hpp"
+#include "utils/measurements-reporter.hpp"
 
 namespace ndnc::posix {
 struct ConsumerOptions {
@@ -49,6 +54,15 @@ struct ConsumerOptions {
 
     // Influxdb URL
     std::string influxdb = "";
+    // Prometheus metrics endpoint, "host:port" or "unix:/path". Empty
+    // disables the endpoint
+    std::string metricsAddress = "";
+    // Trace one in every traceSampling Interests through the pipeline stages.
+    // Zero disables tracing
+    size_t traceSampling = 0;
+    // Chrome trace JSON file with the sampled Interests, written when the
+    // consumer is destroyed. Empty disables the export
+    std::string traceFile = "";
 
     // Name prefix
     ndn::Name prefix = ndn::Name("/ndnc/xrootd");
@@ -59,6 +73,18 @@ struct ConsumerOptions {
     PipelineType pipelineType = PipelineType::aimd;
     // Pipeline size
     size_t pipelineSize = 32768;
+    // Threads verifying Data signatures. Zero disables verification
+    size_t verifyThreads = 0;
+    // Accept verified Data whose signature type has no validator
+    bool acceptUnknownSignatureTypes = false;
+    // Interests pushed but not yet satisfied or failed, across all consumers.
+    // Pushing blocks once the limit is reached
+    size_t maxPendingInterests = 65536;
+
+    // Metadata cache TTL. Zero disables caching
+    ndn::time::milliseconds metadataCacheTTL{5000};
+    // Metadata cache TTL for Nack responses. Zero disables negative caching
+    ndn::time::milliseconds metadataNegativeCacheTTL{1000};
 
     std::string to_string() {
         std::string asString = "";
@@ -76,6 +102,25 @@ struct ConsumerOptions {
         }
 
         asString += ",pipelineSize=" + std::to_string(pipelineSize);
+        asString += ",verifyThreads=" + std::to_string(verifyThreads);
+        if (acceptUnknownSignatureTypes) {
+            asString += ",acceptUnknownSignatureTypes";
+        }
+        asString +=
+            ",maxPendingInterests=" + std::to_string(maxPendingInterests);
+        asString +=
+            ",metadataCacheTTL=" + std::to_string(metadataCacheTTL.count()) +
+            "ms";
+        asString += ",metadataNegativeCacheTTL=" +
+                    std::to_string(metadataNegativeCacheTTL.count()) + "ms";
+
+        if (!metricsAddress.empty()) {
+            asString += ",metricsAddress=" + metricsAddress;
+        }
+
+        if (traceSampling > 0) {
+            asString += ",traceSampling=" + std::to_string(traceSampling);
+        }
 
         return asString;
     }
@@ -84,6 +129,34 @@ struct ConsumerOptions {
 
 namespace ndnc::posix {
 class Consumer : public std::enable_shared_from_this<Consumer> {
+  public:
+    /**
+     * @brief Invoked for each Data packet of a streaming request, in arrival
+     * order. Return false to mark the request as failed
+     *
+     */
+    using OnData = std::function<bool(const ndn::Data &)>;
+
+    /**
+     * @brief Invoked from the completion thread once all Data packets of an
+     * asynchronous request have been received or on error
+     *
+     */
+    using OnRequestCompleted = std::function<void(bool ok)>;
+
+  private:
+    struct AsyncRequest {
+        uint64_t id = 0;
+        // Pushed by the completion thread as credits become available
+        std::vector<std::shared_ptr<ndn::Interest>> interests;
+        size_t pushed = 0;
+        size_t expected = 0;
+        size_t received = 0;
+        bool failed = false;
+        OnData onData;
+        OnRequestCompleted onCompleted;
+    };
+
   public:
     Consumer(ConsumerOptions options);
     ~Consumer();
@@ -108,8 +181,79 @@ class Consumer : public std::enable_shared_from_this<Consumer> {
     asyncRequestDataFor(std::vector<std::shared_ptr<ndn::Interest>> &&interests,
                         uint64_t id);
 
+    /**
+     * @brief Request a list of Data packets and hand each one to onData as
+     * soon as it arrives. On error, the remaining responses are drained so
+     * they are not delivered to a later request on the same consumer id
+     *
+     * @param interests The Interest packets
+     * @param id The consumer id
+     * @param onData Called for each received Data packet
+     * @return true All Data packets were received and accepted by onData
+     * @return false Pipeline error or a Data packet was rejected
+     */
+    bool
+    syncRequestDataFor(std::vector<std::shared_ptr<ndn::Interest>> &&interests,
+                       uint64_t id, OnData onData);
+
+    /**
+     * @brief Request a list of Data packets without blocking the caller.
+     * The completion thread pushes the Interests as credits become available
+     * and invokes both callbacks
+     *
+     * @param interests The Interest packets
+     * @param onData Called for each received Data packet
+     * @param onCompleted Called once the request is complete or on error
+     * @return true The request was queued for the completion thread
+     * @return false Unable to queue the request
+     */
+    bool
+    asyncRequestDataFor(std::vector<std::shared_ptr<ndn::Interest>> &&interests,
+                        OnData onData, OnRequestCompleted onCompleted);
+
+    /**
+     * @brief Push Interest packets from offset onwards for as many credits as
+     * are available, without waiting. For callers that pop the responses on
+     * the same thread with getData, since unpopped responses hold credits
+     *
+     * @param offset Index of the first Interest to push, advanced past the
+     * pushed ones
+     * @return false Unable to push the Interest packets to the pipeline
+     */
+    bool
+    tryRequestDataFor(std::vector<std::shared_ptr<ndn::Interest>> &interests,
+                      size_t &offset, uint64_t id);
+
     size_t getData(std::vector<std::shared_ptr<ndn::Data>> &pkts, uint64_t id);
 
+    /**
+     * @brief Get the RDR metadata of a file or directory. Served from the
+     * metadata cache while fresh, otherwise requested from the network
+     *
+     * @param path The file or directory path
+     * @param metadata The metadata, on success
+     * @return int 0 on success, -ENOENT if the producer replied with a Nack
+     * and -1 on error
+     */
+    int getFileMetadata(const std::string &path,
+                        std::shared_ptr<FileMetadata> &metadata);
+
+    /**
+     * @brief Register the validator of a signature type with the pipeline
+     * verification stage
+     *
+     * @return false if verification is disabled
+     */
+    bool setDataValidator(uint32_t signatureType,
+                          ndnc::DataVerifier::Validator validator);
+
+    /**
+     * @brief Record a completed read with the InfluxDB reporter shared by all
+     * files opened through this consumer. No-op if reporting is disabled
+     *
+     */
+    void recordRead(size_t bytes, std::chrono::nanoseconds latency);
+
   public:
     ndn::Name getNamePrefix();
     ndnc::PipelineCounters getCounters();
@@ -118,14 +262,27 @@ class Consumer : public std::enable_shared_from_this<Consumer> {
   private:
     void openFace();
     void openPipeline();
+    void completeAsyncRequests();
+    void registerMetrics();
+    void openReporter();
 
   private:
     ConsumerOptions options_;
     std::unique_ptr<ndnc::face::Face> face_;
     std::shared_ptr<ndnc::PipelineInterests> pipeline_;
+    MetadataCache metadataCache_;
+    // Metadata cache lookups, indexed by MetadataCache::Lookup
+    std::array<std::atomic_uint64_t, 3> metadataLookups_;
+    uint64_t metricsHandle_;
+    std::unique_ptr<ndnc::MeasurementsReporter> reporter_;
 
     std::atomic_bool is_valid_;
     std::atomic_bool error_;
+
+    moodycamel::BlockingConcurrentQueue<AsyncRequest> asyncRequests_;
+    std::once_flag asyncWorkerFlag_;
+    std::thread asyncWorker_;
+    std::atomic_bool stop_;
 };
 }; // namespace ndnc::posix
 
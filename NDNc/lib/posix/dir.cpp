@@ -99,27 +99,11 @@ bool Dir::getDirMetadata(const char *path) {
         return false;
     }
 
-    auto interest =
-        std::make_shared<ndn::Interest>(rdrDiscoveryNameFileRetrieval(
-            std::string(path), consumer_->getNamePrefix()));
-    interest->setCanBePrefix(true);
-    interest->setMustBeFresh(true);
-
-    auto id = consumer_->registerConsumer();
-    auto data = consumer_->syncRequestDataFor(std::move(interest), id);
-    consumer_->unregisterConsumer(id);
-
-    if (data == nullptr || !data->hasContent()) {
-        LOG_ERROR("dir metadata: invalid data");
-        return false;
-    }
-
-    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+    if (consumer_->getFileMetadata(std::string(path), metadata_) != 0) {
         LOG_ERROR("unable to list dir '%s'", path);
         return false;
     }
 
-    metadata_ = std::make_shared<FileMetadata>(data->getContent());
     return true;
 }
 
@@ -29,7 +29,6 @@
 #define NDNC_LIB_POSIX_FILE_METADATA_HPP
 
 #include <cstdint>
-#include <math.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
 
@@ -82,8 +81,9 @@ class FileMetadata {
         this->versionedName_ =
             name.appendVersion(timestamp_to_uint64(stx_.stx_mtime));
 
+        // Last segment number, inclusive
         this->finalBlockId_ =
-            (uint64_t)(ceil((double)stx_.stx_size / segmentSize_));
+            stx_.stx_size == 0 ? 0 : (stx_.stx_size - 1) / segmentSize_;
 
         return true;
     }
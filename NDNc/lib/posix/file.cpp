@@ -25,23 +25,14 @@
  * SOFTWARE.
  */
 
-#include <algorithm>
-#include <cmath>
+#include <cerrno>
 
 #include "file.hpp"
 #include "logger/logger.hpp"
 
 namespace ndnc::posix {
 File::File(std::shared_ptr<Consumer> consumer)
-    : consumer_{consumer}, metadata_{nullptr}, reporter_{nullptr}, path_{},
-      consumer_ids_{} {
-
-    if (!consumer_->getOptions().influxdb.empty()) {
-        reporter_ = std::make_unique<ndnc::MeasurementsReporter>(
-            256, consumer->getOptions().to_string());
-        reporter_->init("xrd", consumer->getOptions().influxdb);
-    }
-}
+    : consumer_{consumer}, metadata_{nullptr}, path_{}, consumer_ids_{} {}
 
 File::~File() {
     close();
@@ -81,10 +72,6 @@ int File::close() {
     }
 
     if (!consumer_ids_.empty()) {
-        if (reporter_ != nullptr) {
-            reporter_.reset();
-        }
-
         metadata_ = nullptr;
     }
 
@@ -108,7 +95,7 @@ int File::stat(const char *path, struct stat *buf) {
 int File::fstat(struct stat *buf) {
     if (!isOpened()) {
         LOG_ERROR("file not opened");
-        return -1;
+        return -EBADF;
     }
 
     metadata_->fstat(buf);
@@ -116,90 +103,131 @@ int File::fstat(struct stat *buf) {
 }
 
 ssize_t File::read(void *buf, off_t offset, size_t blen) {
+    ReadChunk chunk{buf, offset, blen};
+    return readChunks(&chunk, 1);
+}
+
+ssize_t File::readv(const ReadChunk *chunks, int n) {
     if (!isOpened()) {
-        LOG_ERROR("read: file not opened");
-        return -1;
+        LOG_ERROR("readv: file not opened");
+        return -EBADF;
+    }
+
+    // Unlike read, a vectored read fails if any chunk is cut short
+    for (int i = 0; i < n; ++i) {
+        if (chunks[i].offset >= 0 &&
+            static_cast<uint64_t>(chunks[i].offset) + chunks[i].len >
+                metadata_->getFileSize()) {
+            LOG_ERROR("readv: chunk past end of file offset=%ld len=%zu",
+                      chunks[i].offset, chunks[i].len);
+            return -ESPIPE;
+        }
     }
 
-    auto indexFirstSegment = offset / metadata_->getSegmentSize();
-    auto indexLastSegment = ceil(
-        (offset + blen) / static_cast<double>(metadata_->getSegmentSize()));
+    return readChunks(chunks, n);
+}
 
-    std::vector<std::shared_ptr<ndn::Interest>> pkts;
-    for (auto segment = indexFirstSegment; segment < indexLastSegment;
-         ++segment) {
-        auto interest = std::make_shared<ndn::Interest>(
-            metadata_->getVersionedName().deepCopy().appendSegment(segment));
-        pkts.emplace_back(std::move(interest));
+ssize_t File::readChunks(const ReadChunk *chunks, int n) {
+    if (!isOpened()) {
+        LOG_ERROR("read: file not opened");
+        return -EBADF;
     }
 
-    auto response =
-        consumer_->syncRequestDataFor(std::move(pkts), getConsumerId());
-    if (response.empty()) {
-        return -1;
+    for (int i = 0; i < n; ++i) {
+        if (chunks[i].offset < 0) {
+            LOG_ERROR("read: negative offset");
+            return -EINVAL;
+        }
+    }
+
+    ReadAssembler assembler(chunks, n, metadata_->getSegmentSize(),
+                            metadata_->getFileSize());
+
+    if (assembler.getSegments().empty()) {
+        return 0;
     }
 
-    std::sort(response.begin(), response.end(),
-              [](const std::shared_ptr<ndn::Data> data1,
-                 const std::shared_ptr<ndn::Data> data2) {
-                  return data1->getName().at(-1).toSegment() <
-                         data2->getName().at(-1).toSegment();
-              });
+    auto start = std::chrono::steady_clock::now();
 
-    ssize_t n = 0;
-    auto blen_copy = blen;
+    if (!consumer_->syncRequestDataFor(
+            getSegmentInterests(assembler.getSegments()), getConsumerId(),
+            [&assembler](const ndn::Data &data) {
+                return assembler.add(data);
+            })) {
+        return -EIO;
+    }
 
-    auto copyDataContent = [&](const ndn::Block &block, size_t off) {
-        auto len = std::min(block.value_size() - off, blen);
-        memcpy((uint8_t *)buf + n, block.value() + off, len);
-        n += len;
-        blen -= len;
-    };
+    report(assembler.getBytesCount(), start);
+    return assembler.getBytesCount();
+}
 
-    auto it = response.begin();
-    copyDataContent(it->get()->getContent(),
-                    offset % metadata_->getSegmentSize());
-    ++it;
+int File::asyncRead(void *buf, off_t offset, size_t blen,
+                    OnReadCompleted onCompleted) {
+    if (!isOpened()) {
+        LOG_ERROR("async read: file not opened");
+        return -EBADF;
+    }
 
-    for (; it != response.end(); ++it) {
-        copyDataContent(it->get()->getContent(), 0);
+    if (offset < 0) {
+        LOG_ERROR("async read: negative offset");
+        return -EINVAL;
     }
 
-    if (reporter_ != nullptr) {
-        auto counters = consumer_->getCounters();
-        reporter_->write(counters.tx, counters.rx, blen_copy,
-                         counters.getAverageDelay().count());
+    ReadChunk chunk{buf, offset, blen};
+    auto assembler = std::make_shared<ReadAssembler>(
+        &chunk, 1, metadata_->getSegmentSize(), metadata_->getFileSize());
+
+    if (assembler->getSegments().empty()) {
+        onCompleted(0);
+        return 0;
     }
 
-    return n;
+    auto self = shared_from_this();
+    auto start = std::chrono::steady_clock::now();
+    auto submitted = consumer_->asyncRequestDataFor(
+        getSegmentInterests(assembler->getSegments()),
+        [assembler](const ndn::Data &data) { return assembler->add(data); },
+        [self, assembler, onCompleted, start](bool ok) {
+            if (!ok) {
+                onCompleted(-EIO);
+                return;
+            }
+
+            self->report(assembler->getBytesCount(), start);
+            onCompleted(assembler->getBytesCount());
+        });
+
+    return submitted ? 0 : -EIO;
 }
 
-bool File::getFileMetadata(const char *path) {
-    if (isOpened()) {
-        LOG_DEBUG("file already opened");
-        return false;
+std::vector<std::shared_ptr<ndn::Interest>>
+File::getSegmentInterests(const std::vector<uint64_t> &segments) {
+    std::vector<std::shared_ptr<ndn::Interest>> pkts;
+    pkts.reserve(segments.size());
+
+    for (auto segment : segments) {
+        pkts.emplace_back(std::make_shared<ndn::Interest>(
+            metadata_->getVersionedName().deepCopy().appendSegment(segment)));
     }
 
-    auto interest =
-        std::make_shared<ndn::Interest>(rdrDiscoveryNameFileRetrieval(
-            std::string(path), consumer_->getNamePrefix()));
-    interest->setCanBePrefix(true);
-    interest->setMustBeFresh(true);
+    return pkts;
+}
 
-    auto data =
-        consumer_->syncRequestDataFor(std::move(interest), getConsumerId());
+void File::report(size_t bytes, std::chrono::steady_clock::time_point start) {
+    consumer_->recordRead(bytes, std::chrono::steady_clock::now() - start);
+}
 
-    if (data == nullptr || !data->hasContent()) {
-        LOG_ERROR("file metadata: invalid data");
+bool File::getFileMetadata(const char *path) {
+    if (isOpened()) {
+        LOG_DEBUG("file already opened");
         return false;
     }
 
-    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+    if (consumer_->getFileMetadata(std::string(path), metadata_) != 0) {
         LOG_ERROR("unable to list file '%s'", path);
         return false;
     }
 
-    metadata_ = std::make_shared<FileMetadata>(data->getContent());
     return true;
 }
 
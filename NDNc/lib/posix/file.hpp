@@ -28,6 +28,7 @@
 #ifndef NDNC_LIB_POSIX_FILE_HPP
 #define NDNC_LIB_POSIX_FILE_HPP
 
+#include <chrono>
 #include <mutex>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -35,10 +36,18 @@
 
 #include "consumer.hpp"
 #include "file-metadata.hpp"
-#include "utils/measurements-reporter.hpp"
+#include "read-assembler.hpp"
 
 namespace ndnc::posix {
-class File {
+class File : public std::enable_shared_from_this<File> {
+  public:
+    /**
+     * @brief Invoked once an asynchronous read completes
+     *
+     * @param n The number of bytes read or a negative errno on error
+     */
+    using OnReadCompleted = std::function<void(ssize_t n)>;
+
   public:
     File(std::shared_ptr<Consumer> consumer);
     ~File();
@@ -47,17 +56,50 @@ class File {
     int close();
     int stat(const char *path, struct stat *buf);
     int fstat(struct stat *buf);
+
+    /**
+     * @brief Read up to blen bytes; the read is shortened at the end of file
+     *
+     * @return ssize_t The number of bytes read or a negative errno on error
+     */
     ssize_t read(void *buf, off_t offset, size_t blen);
 
+    /**
+     * @brief Vectored read. The union of all segments needed by the chunks is
+     * requested in a single bulk request and the content is scattered into
+     * the buffers of each chunk. Every chunk must be fully inside the file
+     *
+     * @param chunks The list of chunks to read
+     * @param n The number of chunks
+     * @return ssize_t The total number of bytes read, -ESPIPE if a chunk runs
+     * past the end of file or another negative errno on error
+     */
+    ssize_t readv(const ReadChunk *chunks, int n);
+
+    /**
+     * @brief Read without blocking the caller. The segment Interests are
+     * submitted to the pipeline and onCompleted is called from the consumer
+     * completion thread once all Data has been assembled into buf
+     *
+     * @return int 0 if the read was submitted, a negative errno otherwise
+     */
+    int asyncRead(void *buf, off_t offset, size_t blen,
+                  OnReadCompleted onCompleted);
+
   private:
     bool isOpened();
     bool getFileMetadata(const char *path);
     uint64_t getConsumerId();
 
+    ssize_t readChunks(const ReadChunk *chunks, int n);
+
+    std::vector<std::shared_ptr<ndn::Interest>>
+    getSegmentInterests(const std::vector<uint64_t> &segments);
+    void report(size_t bytes, std::chrono::steady_clock::time_point start);
+
   private:
     std::shared_ptr<Consumer> consumer_;
     std::shared_ptr<FileMetadata> metadata_;
-    std::unique_ptr<ndnc::MeasurementsReporter> reporter_;
     std::string path_;
 
     std::unordered_map<std::thread::id, uint64_t> consumer_ids_;
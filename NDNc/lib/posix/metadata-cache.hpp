@@ -0,0 +1,139 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_METADATA_CACHE_HPP
+#define NDNC_LIB_POSIX_METADATA_CACHE_HPP
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <ndn-cxx/util/time.hpp>
+
+#include "file-metadata.hpp"
+
+namespace ndnc::posix {
+/**
+ * @brief Cache of RDR metadata keyed by path. Positive entries expire after
+ * ttl, Nack responses are cached as negative entries for negativeTtl
+ *
+ */
+class MetadataCache {
+  private:
+    struct Entry {
+        // nullptr for negative entries
+        std::shared_ptr<FileMetadata> metadata;
+        ndn::time::steady_clock::TimePoint expiresAt;
+    };
+
+  public:
+    enum class Lookup
+    {
+        miss = 0,
+        hit = 1,
+        negative = 2
+    };
+
+  public:
+    MetadataCache(ndn::time::milliseconds ttl,
+                  ndn::time::milliseconds negativeTtl, size_t capacity = 65536)
+        : ttl_{ttl}, negativeTtl_{negativeTtl}, capacity_{capacity} {
+    }
+
+    Lookup find(const std::string &path,
+                std::shared_ptr<FileMetadata> &metadata) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = entries_.find(path);
+        if (it == entries_.end()) {
+            return Lookup::miss;
+        }
+
+        if (it->second.expiresAt <= ndn::time::steady_clock::now()) {
+            entries_.erase(it);
+            return Lookup::miss;
+        }
+
+        metadata = it->second.metadata;
+        return metadata == nullptr ? Lookup::negative : Lookup::hit;
+    }
+
+    void insert(const std::string &path,
+                std::shared_ptr<FileMetadata> metadata) {
+        insert(path, metadata, ttl_);
+    }
+
+    void insertNegative(const std::string &path) {
+        insert(path, nullptr, negativeTtl_);
+    }
+
+    void erase(const std::string &path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.erase(path);
+    }
+
+  private:
+    void insert(const std::string &path,
+                std::shared_ptr<FileMetadata> metadata,
+                ndn::time::milliseconds ttl) {
+        if (ttl <= ndn::time::milliseconds{0}) {
+            return;
+        }
+
+        auto now = ndn::time::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (entries_.size() >= capacity_) {
+            evict(now);
+        }
+
+        entries_[path] = Entry{metadata, now + ttl};
+    }
+
+    void evict(ndn::time::steady_clock::TimePoint now) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            it = it->second.expiresAt <= now ? entries_.erase(it) : ++it;
+        }
+
+        // Still full of fresh entries; drop some to make room
+        for (auto it = entries_.begin();
+             entries_.size() >= capacity_ && it != entries_.end();) {
+            it = entries_.erase(it);
+        }
+    }
+
+  private:
+    ndn::time::milliseconds ttl_;
+    ndn::time::milliseconds negativeTtl_;
+    size_t capacity_;
+
+    std::unordered_map<std::string, Entry> entries_;
+    std::mutex mutex_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_METADATA_CACHE_HPP
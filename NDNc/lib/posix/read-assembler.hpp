@@ -0,0 +1,162 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_READ_ASSEMBLER_HPP
+#define NDNC_LIB_POSIX_READ_ASSEMBLER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+
+namespace ndnc::posix {
+/**
+ * @brief One element of a vectored read: read len bytes starting at file
+ * offset into buf
+ *
+ */
+struct ReadChunk {
+    void *buf;
+    off_t offset;
+    size_t len;
+};
+
+/**
+ * @brief Copy the content of each segment straight into its final position in
+ * the destination buffers as Data packets arrive, in any order. The segment
+ * number is decoded once per Data packet and no reordering is needed
+ *
+ */
+class ReadAssembler {
+  public:
+    ReadAssembler(const ReadChunk *chunks, int n, uint64_t segmentSize,
+                  uint64_t fileSize)
+        : chunks_(chunks, chunks + n), segmentSize_{segmentSize},
+          fileSize_{fileSize}, bytes_{0} {
+
+        for (int i = 0; i < n; ++i) {
+            auto end = getChunkEnd(chunks_[i]);
+
+            for (uint64_t segment = chunks_[i].offset / segmentSize_;
+                 segment * segmentSize_ < end; ++segment) {
+                segmentChunks_[segment].push_back(i);
+            }
+        }
+
+        segments_.reserve(segmentChunks_.size());
+        for (auto &it : segmentChunks_) {
+            segments_.push_back(it.first);
+        }
+        std::sort(segments_.begin(), segments_.end());
+    }
+
+    /**
+     * @brief Get the sorted list of segments needed to complete the read
+     *
+     */
+    const std::vector<uint64_t> &getSegments() const {
+        return segments_;
+    }
+
+    /**
+     * @brief Copy the content of a Data packet into all chunks it overlaps
+     *
+     * @param data The Data packet of one of the requested segments
+     * @return true The content was copied
+     * @return false The Data packet is not a pending segment of this read
+     */
+    bool add(const ndn::Data &data) {
+        if (data.getName().empty() || !data.getName().at(-1).isSegment()) {
+            return false;
+        }
+
+        // The producer could not serve this version of the file
+        if (data.getContentType() == ndn::tlv::ContentType_Nack) {
+            return false;
+        }
+
+        auto segment = data.getName().at(-1).toSegment();
+        auto it = segmentChunks_.find(segment);
+
+        if (it == segmentChunks_.end()) {
+            return false;
+        }
+
+        for (auto i : it->second) {
+            copy(chunks_[i], segment, data.getContent());
+        }
+
+        segmentChunks_.erase(it);
+        return true;
+    }
+
+    bool isComplete() const {
+        return segmentChunks_.empty();
+    }
+
+    size_t getBytesCount() const {
+        return bytes_;
+    }
+
+  private:
+    uint64_t getChunkEnd(const ReadChunk &chunk) const {
+        return std::min(static_cast<uint64_t>(chunk.offset) + chunk.len,
+                        fileSize_);
+    }
+
+    void copy(const ReadChunk &chunk, uint64_t segment,
+              const ndn::Block &content) {
+        uint64_t segmentBegin = segment * segmentSize_;
+        uint64_t begin =
+            std::max(segmentBegin, static_cast<uint64_t>(chunk.offset));
+        uint64_t end = std::min(segmentBegin + content.value_size(),
+                                getChunkEnd(chunk));
+
+        if (begin >= end) {
+            return;
+        }
+
+        memcpy(static_cast<uint8_t *>(chunk.buf) + (begin - chunk.offset),
+               content.value() + (begin - segmentBegin), end - begin);
+        bytes_ += end - begin;
+    }
+
+  private:
+    std::vector<ReadChunk> chunks_;
+    std::unordered_map<uint64_t, std::vector<int>> segmentChunks_;
+    std::vector<uint64_t> segments_;
+
+    uint64_t segmentSize_;
+    uint64_t fileSize_;
+    size_t bytes_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_READ_ASSEMBLER_HPP
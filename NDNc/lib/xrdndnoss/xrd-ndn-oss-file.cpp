@@ -70,16 +70,41 @@ ssize_t XrdNdnOssFile::Read(void *buff, off_t offset, size_t blen) {
 }
 
 int XrdNdnOssFile::Read(XrdSfsAio *aoip) {
-    aoip->Result = Read((void *)aoip->sfsAio.aio_buf, aoip->sfsAio.aio_offset,
-                        aoip->sfsAio.aio_nbytes);
-    aoip->doneRead();
-    return 0;
+    if (file_ == nullptr) {
+        return -EINVAL;
+    }
+
+    // doneRead() is called from the consumer completion thread
+    auto res = file_->asyncRead(
+        (void *)aoip->sfsAio.aio_buf, aoip->sfsAio.aio_offset,
+        aoip->sfsAio.aio_nbytes, [aoip](ssize_t n) {
+            aoip->Result = n;
+            aoip->doneRead();
+        });
+
+    return res;
 }
 
 ssize_t XrdNdnOssFile::ReadRaw(void *buff, off_t offset, size_t blen) {
     return Read(buff, offset, blen);
 }
 
+ssize_t XrdNdnOssFile::ReadV(XrdOucIOVec *readV, int rdvcnt) {
+    if (file_ == nullptr) {
+        return -EINVAL;
+    }
+
+    std::vector<ndnc::posix::ReadChunk> chunks;
+    chunks.reserve(rdvcnt);
+
+    for (int i = 0; i < rdvcnt; ++i) {
+        chunks.push_back({readV[i].data, static_cast<off_t>(readV[i].offset),
+                          static_cast<size_t>(readV[i].size)});
+    }
+
+    return file_->readv(chunks.data(), rdvcnt);
+}
+
 int XrdNdnOssFile::Close(long long * = 0) {
     if (file_ == nullptr) {
         return 0;
@@ -28,6 +28,8 @@
 #ifndef NDNC_LIB_XRD_NDN_OSS_FILE_HPP
 #define NDNC_LIB_XRD_NDN_OSS_FILE_HPP
 
+#include <XrdOuc/XrdOucIOVec.hh>
+
 #include "lib/posix/file.hpp"
 #include "xrd-ndn-oss.hpp"
 
@@ -46,6 +48,7 @@ class XrdNdnOssFile : public XrdOssDF {
     ssize_t Read(void *, off_t, size_t);
     int Read(XrdSfsAio *);
     ssize_t ReadRaw(void *, off_t, size_t);
+    ssize_t ReadV(XrdOucIOVec *, int);
     int Close(long long *);
     int Fchmod(mode_t);
     int Fsync();
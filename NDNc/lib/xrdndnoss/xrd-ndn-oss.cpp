@@ -97,9 +97,41 @@ XrdOss *XrdOssGetStorageSystem(XrdOss *, XrdSysLogger *Logger,
         "       ofs NDNc consumer. pipelineSize=",
         std::to_string(XrdNdnOfs.options_.pipelineSize).c_str());
 
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. verifyThreads=",
+        std::to_string(XrdNdnOfs.options_.verifyThreads).c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. acceptUnknownSignatureTypes=",
+        std::to_string(XrdNdnOfs.options_.acceptUnknownSignatureTypes)
+            .c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. maxPendingInterests=",
+        std::to_string(XrdNdnOfs.options_.maxPendingInterests).c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. metadataCacheTTL=",
+        std::to_string(XrdNdnOfs.options_.metadataCacheTTL.count()).c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. metadataNegativeCacheTTL=",
+        std::to_string(XrdNdnOfs.options_.metadataNegativeCacheTTL.count())
+            .c_str());
+
     XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. influxdb url=",
                           XrdNdnOfs.options_.influxdb.c_str());
 
+    XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. metricsAddress=",
+                          XrdNdnOfs.options_.metricsAddress.c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. traceSampling=",
+        std::to_string(XrdNdnOfs.options_.traceSampling).c_str());
+
+    XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. traceFile=",
+                          XrdNdnOfs.options_.traceFile.c_str());
+
     XrdNdnOfs.eDest_->Say(
         "------ Named Data Networking Storage System configuration completed.");
 
@@ -216,8 +248,17 @@ int XrdNdnOss::Rename(const char *, const char *, XrdOucEnv *, XrdOucEnv *) {
 
 int XrdNdnOss::Stat(const char *path, struct stat *buff, int = 0,
                     XrdOucEnv * = 0) {
-    auto file = std::make_shared<ndnc::posix::File>(this->consumer_);
-    return file->stat(path, buff);
+    std::shared_ptr<ndnc::posix::FileMetadata> metadata;
+
+    // -ENOENT when the producer replied with a Nack, otherwise the metadata
+    // could not be retrieved
+    auto res = this->consumer_->getFileMetadata(std::string(path), metadata);
+    if (res != 0) {
+        return res == -ENOENT ? -ENOENT : -EIO;
+    }
+
+    metadata->fstat(buff);
+    return XrdOssOK;
 }
 
 int XrdNdnOss::Truncate(const char *, unsigned long long, XrdOucEnv *) {
@@ -358,6 +399,68 @@ bool XrdNdnOss::Config(const char *parms) {
         }
     }
 
+    {
+        int verifyThreads = 0;
+        if (getIntFromParams("verifyThreads", verifyThreads)) {
+            if (verifyThreads < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid verifyThreads value. this argument will be "
+                     "ignored");
+            } else {
+                options_.verifyThreads = verifyThreads;
+            }
+        }
+    }
+
+    {
+        int acceptUnknown = 0;
+        if (getIntFromParams("acceptUnknownSignatureTypes", acceptUnknown)) {
+            options_.acceptUnknownSignatureTypes = acceptUnknown != 0;
+        }
+    }
+
+    {
+        int maxPendingInterests = 0;
+        if (getIntFromParams("maxPendingInterests", maxPendingInterests)) {
+            if (maxPendingInterests <= 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid maxPendingInterests value. this argument will "
+                     "be ignored");
+            } else {
+                options_.maxPendingInterests = maxPendingInterests;
+            }
+        }
+    }
+
+    {
+        int metadataCacheTTL = 0;
+        if (getIntFromParams("metadataCacheTTL", metadataCacheTTL)) {
+            if (metadataCacheTTL < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid metadataCacheTTL value. this argument will be "
+                     "ignored");
+            } else {
+                options_.metadataCacheTTL =
+                    ndn::time::milliseconds{metadataCacheTTL};
+            }
+        }
+    }
+
+    {
+        int metadataNegativeCacheTTL = 0;
+        if (getIntFromParams("metadataNegativeCacheTTL",
+                             metadataNegativeCacheTTL)) {
+            if (metadataNegativeCacheTTL < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid metadataNegativeCacheTTL value. this argument "
+                     "will be ignored");
+            } else {
+                options_.metadataNegativeCacheTTL =
+                    ndn::time::milliseconds{metadataNegativeCacheTTL};
+            }
+        }
+    }
+
     {
         std::string influxdb = "";
         if (getStringFromParams("influxdb", influxdb)) {
@@ -365,6 +468,33 @@ bool XrdNdnOss::Config(const char *parms) {
         }
     }
 
+    {
+        std::string metricsAddress = "";
+        if (getStringFromParams("metricsAddress", metricsAddress)) {
+            options_.metricsAddress = metricsAddress;
+        }
+    }
+
+    {
+        int traceSampling = 0;
+        if (getIntFromParams("traceSampling", traceSampling)) {
+            if (traceSampling < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid traceSampling value. this argument will be "
+                     "ignored");
+            } else {
+                options_.traceSampling = traceSampling;
+            }
+        }
+    }
+
+    {
+        std::string traceFile = "";
+        if (getStringFromParams("traceFile", traceFile)) {
+            options_.traceFile = traceFile;
+        }
+    }
+
     return true;
 }
 }; // namespace xrdndnofs
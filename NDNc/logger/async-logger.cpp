@@ -0,0 +1,279 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "async-logger.hpp"
+#include "zf_log.h"
+
+namespace ndnc {
+namespace logger {
+std::atomic_bool asyncLoggingEnabled{false};
+
+RecordRing::RecordRing(size_t capacity)
+    : tid{static_cast<pid_t>(syscall(SYS_gettid))}, dropped{0},
+      retired{false}, head_{0}, tail_{0}, headCache_{0} {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    records_.resize(size);
+    mask_ = size - 1;
+}
+
+namespace {
+class Backend {
+  public:
+    static Backend &instance() {
+        static Backend backend;
+        return backend;
+    }
+
+    ~Backend() {
+        stop();
+    }
+
+    bool start(const std::string &path, size_t ringCapacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (running_) {
+            return true;
+        }
+
+        if (path.empty() || path == "stderr") {
+            out_ = stderr;
+        } else if ((out_ = fopen(path.c_str(), "a")) == nullptr) {
+            return false;
+        }
+
+        ringCapacity_ = std::max<size_t>(ringCapacity, 2);
+        running_ = true;
+        worker_ = std::thread(&Backend::run, this);
+        asyncLoggingEnabled = true;
+
+        return true;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (!running_) {
+                return;
+            }
+
+            asyncLoggingEnabled = false;
+            running_ = false;
+        }
+
+        worker_.join();
+
+        if (out_ != stderr) {
+            fclose(out_);
+        }
+        out_ = nullptr;
+    }
+
+    std::shared_ptr<RecordRing> registerRing() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto ring = std::make_shared<RecordRing>(ringCapacity_);
+        rings_.push_back(ring);
+        return ring;
+    }
+
+    uint64_t getDropped() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        uint64_t dropped = retiredDropped_;
+        for (auto &ring : rings_) {
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
+  private:
+    Backend()
+        : out_{nullptr}, running_{false}, ringCapacity_{4096},
+          retiredDropped_{0}, reportedDropped_{0} {
+    }
+
+    void run() {
+        while (true) {
+            bool running = running_;
+
+            // Drain once more after stopping so nothing is left behind
+            if (drain() == 0) {
+                if (!running) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        }
+    }
+
+    size_t drain() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        size_t n = 0;
+        uint64_t dropped = retiredDropped_;
+
+        for (auto it = rings_.begin(); it != rings_.end();) {
+            auto &ring = *it;
+
+            // A retired ring is only removed once empty; its owner is gone
+            auto retired = ring->retired.load(std::memory_order_acquire);
+
+            for (auto record = ring->peek(); record != nullptr;
+                 record = ring->peek()) {
+                write(*record, ring->tid);
+                ring->release();
+                ++n;
+            }
+
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+
+            if (retired) {
+                retiredDropped_ += ring->dropped.load();
+                it = rings_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (dropped > reportedDropped_) {
+            fprintf(out_, "async logger: dropped %lu records\n",
+                    dropped - reportedDropped_);
+            reportedDropped_ = dropped;
+        }
+
+        if (n > 0) {
+            fflush(out_);
+        }
+
+        return n;
+    }
+
+    void write(const Record &record, pid_t tid) {
+        static const char levels[] = {'?', 'V', 'D', 'I', 'W', 'E', 'F'};
+
+        char message[1024];
+        record.formatter(record, message, sizeof(message));
+
+        auto time = std::chrono::system_clock::to_time_t(record.time);
+        auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        record.time.time_since_epoch())
+                        .count() %
+                    1000;
+
+        struct tm tm;
+        localtime_r(&time, &tm);
+
+        const char *file = strrchr(record.file, '/');
+        file = file != nullptr ? file + 1 : record.file;
+
+        fprintf(out_, "%02d-%02d %02d:%02d:%02d.%03d %5i %5i %c %s:%u %s\n",
+                tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                static_cast<int>(msec), getpid(), tid,
+                record.level < sizeof(levels) ? levels[record.level] : '?',
+                file, record.line, message);
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<RecordRing>> rings_;
+    std::thread worker_;
+
+    FILE *out_;
+    std::atomic_bool running_;
+    size_t ringCapacity_;
+
+    uint64_t retiredDropped_;
+    uint64_t reportedDropped_;
+};
+
+/**
+ * @brief Owns the ring of a thread and retires it when the thread exits
+ *
+ */
+struct ThreadRing {
+    ~ThreadRing() {
+        if (ring != nullptr) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<RecordRing> ring;
+};
+
+thread_local ThreadRing threadRing;
+
+/**
+ * @brief Start the backend from the NDNC_LOG_ASYNC environment variable
+ *
+ */
+struct AutoStart {
+    AutoStart() {
+        auto path = getenv("NDNC_LOG_ASYNC");
+        if (path != nullptr && !startAsyncLogging(path)) {
+            ZF_LOGW("unable to open %s for async logging", path);
+        }
+    }
+
+    ~AutoStart() {
+        stopAsyncLogging();
+    }
+} autoStart;
+}; // namespace
+
+bool startAsyncLogging(const std::string &path, size_t ringCapacity) {
+    return Backend::instance().start(path, ringCapacity);
+}
+
+void stopAsyncLogging() {
+    Backend::instance().stop();
+}
+
+uint64_t getDroppedLogRecords() {
+    return Backend::instance().getDropped();
+}
+
+RecordRing *getThreadRing() {
+    if (threadRing.ring == nullptr) {
+        threadRing.ring = Backend::instance().registerRing();
+    }
+    return threadRing.ring.get();
+}
+}; // namespace logger
+}; // namespace ndnc
@@ -0,0 +1,319 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LOGGER_ASYNC_LOGGER_HPP
+#define NDNC_LOGGER_ASYNC_LOGGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace ndnc {
+namespace logger {
+/**
+ * @brief Fixed-size log record. The format string and the source location
+ * must be string literals; the arguments are copied into the record and
+ * formatted later by the backend thread
+ *
+ */
+struct alignas(64) Record {
+    using Formatter = int (*)(const Record &record, char *buf, size_t len);
+
+    std::chrono::system_clock::time_point time;
+    const char *file;
+    const char *format;
+    Formatter formatter;
+    uint32_t line;
+    uint8_t level;
+    bool truncated;
+
+    static constexpr size_t RECORD_SIZE = 256;
+    uint8_t args[RECORD_SIZE - 40];
+};
+
+static_assert(sizeof(Record) == Record::RECORD_SIZE, "unexpected padding");
+
+/**
+ * @brief Single-producer single-consumer ring of log records. Each logging
+ * thread owns one; the backend thread is the only consumer
+ *
+ */
+class RecordRing {
+  public:
+    explicit RecordRing(size_t capacity);
+
+    Record *tryClaim() {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == records_.size()) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == records_.size()) {
+                return nullptr;
+            }
+        }
+        return &records_[tail & mask_];
+    }
+
+    void publish() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    const Record *peek() {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &records_[head & mask_];
+    }
+
+    void release() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+  public:
+    pid_t tid;
+    std::atomic_uint64_t dropped;
+    std::atomic_bool retired;
+
+  private:
+    std::vector<Record> records_;
+    size_t mask_;
+
+    alignas(64) std::atomic_size_t head_;
+    alignas(64) std::atomic_size_t tail_;
+    size_t headCache_;
+};
+
+extern std::atomic_bool asyncLoggingEnabled;
+
+/**
+ * @brief Start the backend thread and route LOG_* through per-thread rings.
+ * Setting the NDNC_LOG_ASYNC environment variable to "stderr" or to a file
+ * path does the same at load time
+ *
+ * @param path The output file. Empty for stderr
+ * @param ringCapacity Records per thread ring, rounded up to a power of two
+ * @return true if the backend is running
+ */
+bool startAsyncLogging(const std::string &path = "",
+                       size_t ringCapacity = 4096);
+
+/**
+ * @brief Drain all rings, stop the backend thread and switch back to
+ * synchronous logging
+ *
+ */
+void stopAsyncLogging();
+
+/**
+ * @brief Get the number of records dropped because a ring was full
+ *
+ */
+uint64_t getDroppedLogRecords();
+
+/**
+ * @brief Get the ring of the calling thread, registering it on first use
+ *
+ */
+RecordRing *getThreadRing();
+
+namespace detail {
+class ArgWriter {
+  public:
+    explicit ArgWriter(Record &record)
+        : record_{record}, pos_{0}, size_{sizeof(record.args)} {
+    }
+
+    void put(const void *value, size_t len) {
+        if (pos_ + len > size_) {
+            record_.truncated = true;
+            return;
+        }
+        std::memcpy(record_.args + pos_, value, len);
+        pos_ += len;
+    }
+
+    void putString(const char *value) {
+        if (pos_ >= size_) {
+            record_.truncated = true;
+            return;
+        }
+
+        if (value == nullptr) {
+            value = "(null)";
+        }
+
+        auto len = std::min(std::strlen(value), size_ - pos_ - 1);
+        std::memcpy(record_.args + pos_, value, len);
+        record_.args[pos_ + len] = '\0';
+        pos_ += len + 1;
+    }
+
+  private:
+    Record &record_;
+    size_t pos_;
+    size_t size_;
+};
+
+class ArgReader {
+  public:
+    explicit ArgReader(const Record &record) : record_{record}, pos_{0} {
+    }
+
+    void get(void *value, size_t len) {
+        std::memcpy(value, record_.args + pos_, len);
+        pos_ += len;
+    }
+
+    const char *getString() {
+        auto value = reinterpret_cast<const char *>(record_.args + pos_);
+        pos_ += std::strlen(value) + 1;
+        return value;
+    }
+
+  private:
+    const Record &record_;
+    size_t pos_;
+};
+
+template <typename T, typename Enable = void> struct ArgCodec {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "log arguments must be trivially copyable");
+    using Decoded = T;
+
+    static void encode(ArgWriter &writer, const T &value) {
+        writer.put(&value, sizeof(T));
+    }
+
+    static T decode(ArgReader &reader) {
+        T value;
+        reader.get(&value, sizeof(T));
+        return value;
+    }
+};
+
+// Strings are copied, they may not outlive the call
+template <typename T>
+struct ArgCodec<T, std::enable_if_t<std::is_same<T, const char *>::value ||
+                                    std::is_same<T, char *>::value>> {
+    using Decoded = const char *;
+
+    static void encode(ArgWriter &writer, const char *value) {
+        writer.putString(value);
+    }
+
+    static const char *decode(ArgReader &reader) {
+        return reader.getString();
+    }
+};
+
+template <typename T>
+struct ArgCodec<T, std::enable_if_t<std::is_same<T, std::string>::value>> {
+    using Decoded = const char *;
+
+    static void encode(ArgWriter &writer, const std::string &value) {
+        writer.putString(value.c_str());
+    }
+
+    static const char *decode(ArgReader &reader) {
+        return reader.getString();
+    }
+};
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+template <typename... Args>
+int formatRecord(const Record &record, char *buf, size_t len) {
+    if (record.truncated) {
+        return snprintf(buf, len, "%s (arguments truncated)", record.format);
+    }
+
+    ArgReader reader{record};
+
+    // Braced initialization evaluates the decoders left to right
+    std::tuple<typename ArgCodec<Args>::Decoded...> values{
+        ArgCodec<Args>::decode(reader)...};
+    (void)reader;
+
+    return std::apply(
+        [&](auto... value) {
+            return snprintf(buf, len, record.format, value...);
+        },
+        values);
+}
+#pragma GCC diagnostic pop
+}; // namespace detail
+
+/**
+ * @brief Copy a log call into the ring of the calling thread. Never blocks;
+ * the record is dropped and counted when the ring is full
+ *
+ */
+template <typename... Args>
+void writeAsync(int level, const char *file, unsigned line, const char *format,
+                const Args &...args) {
+    auto ring = getThreadRing();
+    if (ring == nullptr) {
+        return;
+    }
+
+    auto record = ring->tryClaim();
+    if (record == nullptr) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    record->time = std::chrono::system_clock::now();
+    record->file = file;
+    record->line = line;
+    record->level = static_cast<uint8_t>(level);
+    record->format = format;
+    record->truncated = false;
+    record->formatter = &detail::formatRecord<std::decay_t<Args>...>;
+
+    detail::ArgWriter writer{*record};
+    (detail::ArgCodec<std::decay_t<Args>>::encode(writer, args), ...);
+    (void)writer;
+
+    ring->publish();
+}
+}; // namespace logger
+}; // namespace ndnc
+
+#endif // NDNC_LOGGER_ASYNC_LOGGER_HPP
@@ -38,6 +38,7 @@
 #include <cctype>
 #include <string>
 
+#include "async-logger.hpp"
 #include "zf_log.h"
 
 namespace ndnc {
@@ -48,31 +49,60 @@ namespace ndnc {
 #define LOG_LVL_FATAL 6
 #define LOG_LVL_NONE 0xFF
 
+/**
+ * @brief Set the log level at run time. Levels below the one compiled in
+ * (NDNC_MIN_LOG_LEVEL) stay disabled
+ *
+ */
 static inline void set_log_level(const std::string lvl) {
     std::string level = lvl;
     std::transform(level.begin(), level.end(), level.begin(),
                    [](unsigned char c) { return std::tolower(c); });
 
-    if (level.compare("debug")) {
+    if (level == "debug") {
         zf_log_set_output_level(LOG_LVL_DEBUG);
-    } else if (level.compare("info")) {
+    } else if (level == "info") {
         zf_log_set_output_level(LOG_LVL_INFO);
-    } else if (level.compare("warn")) {
+    } else if (level == "warn") {
         zf_log_set_output_level(LOG_LVL_WARN);
-    } else if (level.compare("error")) {
+    } else if (level == "error") {
         zf_log_set_output_level(LOG_LVL_ERROR);
-    } else if (level.compare("fatal")) {
+    } else if (level == "fatal") {
         zf_log_set_output_level(LOG_LVL_FATAL);
     } else {
         zf_log_set_output_level(LOG_LVL_NONE);
     }
 }
 
-#define LOG_DEBUG ZF_LOGD
-#define LOG_INFO ZF_LOGI
-#define LOG_WARN ZF_LOGW
-#define LOG_ERROR ZF_LOGE
-#define LOG_FATAL ZF_LOGF
+/**
+ * @brief True if records of this level are compiled in and enabled at run
+ * time. Guards work done only to build log arguments, e.g.
+ * if (LOG_ON(LOG_LVL_DEBUG)) { ... }
+ *
+ */
+#define LOG_ON(lvl) ZF_LOG_ON(lvl)
+
+// Arguments are evaluated only when the level is enabled. Records go to the
+// async backend when it runs, and are otherwise formatted and written by
+// zf_log on the calling thread
+#define NDNC_LOG_WRITE(lvl, zflog, ...)                                        \
+    do {                                                                       \
+        if (ZF_LOG_ON(lvl)) {                                                  \
+            if (ndnc::logger::asyncLoggingEnabled.load(                        \
+                    std::memory_order_relaxed)) {                              \
+                ndnc::logger::writeAsync(lvl, __FILE__, __LINE__,              \
+                                         __VA_ARGS__);                         \
+            } else {                                                           \
+                zflog(__VA_ARGS__);                                            \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+
+#define LOG_DEBUG(...) NDNC_LOG_WRITE(ZF_LOG_DEBUG, ZF_LOGD, __VA_ARGS__)
+#define LOG_INFO(...) NDNC_LOG_WRITE(ZF_LOG_INFO, ZF_LOGI, __VA_ARGS__)
+#define LOG_WARN(...) NDNC_LOG_WRITE(ZF_LOG_WARN, ZF_LOGW, __VA_ARGS__)
+#define LOG_ERROR(...) NDNC_LOG_WRITE(ZF_LOG_ERROR, ZF_LOGE, __VA_ARGS__)
+#define LOG_FATAL(...) NDNC_LOG_WRITE(ZF_LOG_FATAL, ZF_LOGF, __VA_ARGS__)
 }; // namespace ndnc
 
 #endif // NDNC_LOGGER_HPP
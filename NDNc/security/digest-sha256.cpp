@@ -0,0 +1,153 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include "digest-sha256.hpp"
+
+namespace ndnc::security {
+namespace {
+/**
+ * @brief Get the single signed range of a DigestSha256 Data packet
+ *
+ */
+bool getSignedRange(const ndn::Data &data, ndn::span<const uint8_t> &range) {
+    if (data.getSignatureType() != ndn::tlv::DigestSha256 ||
+        data.getSignatureValue().value_size() != SHA256_DIGEST_SIZE) {
+        return false;
+    }
+
+    try {
+        auto ranges = data.extractSignedRanges();
+        if (ranges.size() != 1) {
+            return false;
+        }
+
+        range = ranges.front();
+        return true;
+    } catch (const ndn::tlv::Error &e) {
+        return false;
+    }
+}
+
+bool matches(const ndn::Data &data, const uint8_t *digest) {
+    return std::equal(digest, digest + SHA256_DIGEST_SIZE,
+                      data.getSignatureValue().value());
+}
+}; // namespace
+
+const ndn::Block &signDigest(ndn::Data &data) {
+    data.setSignatureInfo(ndn::SignatureInfo(ndn::tlv::DigestSha256));
+
+    ndn::EncodingBuffer encoder;
+    data.wireEncode(encoder, true);
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256(encoder.data(), encoder.size(), digest);
+
+    return data.wireEncode(encoder, ndn::make_span(digest));
+}
+
+void signDigestBatch(std::vector<std::shared_ptr<ndn::Data>> &batch) {
+    auto n = batch.size();
+
+    // The unsigned portions must stay alive until the packets are encoded
+    std::vector<ndn::EncodingBuffer> encoders(n);
+    std::vector<const uint8_t *> data(n);
+    std::vector<size_t> len(n);
+    std::vector<uint8_t> digests(n * SHA256_DIGEST_SIZE);
+
+    for (size_t i = 0; i < n; ++i) {
+        batch[i]->setSignatureInfo(
+            ndn::SignatureInfo(ndn::tlv::DigestSha256));
+        batch[i]->wireEncode(encoders[i], true);
+
+        data[i] = encoders[i].data();
+        len[i] = encoders[i].size();
+    }
+
+    sha256Batch(data.data(), len.data(), n, digests.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        batch[i]->wireEncode(
+            encoders[i], ndn::make_span(&digests[i * SHA256_DIGEST_SIZE],
+                                        SHA256_DIGEST_SIZE));
+    }
+}
+
+bool verifyDigest(const ndn::Data &data) {
+    ndn::span<const uint8_t> range;
+    if (!getSignedRange(data, range)) {
+        return false;
+    }
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256(range.data(), range.size(), digest);
+
+    return matches(data, digest);
+}
+
+size_t verifyDigestBatch(const std::vector<std::shared_ptr<ndn::Data>> &batch,
+                         size_t n, std::vector<bool> &valid) {
+    n = std::min(n, batch.size());
+    valid.assign(n, false);
+
+    // Only packets with a well-formed signature are hashed
+    std::vector<size_t> index;
+    std::vector<const uint8_t *> data;
+    std::vector<size_t> len;
+    index.reserve(n);
+    data.reserve(n);
+    len.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        ndn::span<const uint8_t> range;
+        if (batch[i] == nullptr || !getSignedRange(*batch[i], range)) {
+            continue;
+        }
+
+        index.push_back(i);
+        data.push_back(range.data());
+        len.push_back(range.size());
+    }
+
+    std::vector<uint8_t> digests(index.size() * SHA256_DIGEST_SIZE);
+    sha256Batch(data.data(), len.data(), index.size(), digests.data());
+
+    size_t count = 0;
+    for (size_t k = 0; k < index.size(); ++k) {
+        if (matches(*batch[index[k]], &digests[k * SHA256_DIGEST_SIZE])) {
+            valid[index[k]] = true;
+            ++count;
+        }
+    }
+
+    return count;
+}
+}; // namespace ndnc::security
@@ -0,0 +1,71 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_SECURITY_DIGEST_SHA256_HPP
+#define NDNC_SECURITY_DIGEST_SHA256_HPP
+
+#include <memory>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+
+#include "sha256.hpp"
+
+namespace ndnc::security {
+/**
+ * @brief Sign a Data packet with DigestSha256 and encode it
+ *
+ * @return const ndn::Block& The wire encoding of the signed packet
+ */
+const ndn::Block &signDigest(ndn::Data &data);
+
+/**
+ * @brief Sign and encode a batch of Data packets with DigestSha256. The
+ * digests are computed together so the SIMD backends can hash several
+ * packets at once
+ *
+ */
+void signDigestBatch(std::vector<std::shared_ptr<ndn::Data>> &batch);
+
+/**
+ * @brief Check the DigestSha256 signature of a Data packet
+ *
+ */
+bool verifyDigest(const ndn::Data &data);
+
+/**
+ * @brief Check the DigestSha256 signatures of the first n packets of a batch.
+ * Packets with another signature type or a malformed signature are invalid
+ *
+ * @param valid Set to the result of each packet
+ * @return size_t The number of valid packets
+ */
+size_t verifyDigestBatch(const std::vector<std::shared_ptr<ndn::Data>> &batch,
+                         size_t n, std::vector<bool> &valid);
+}; // namespace ndnc::security
+
+#endif // NDNC_SECURITY_DIGEST_SHA256_HPP
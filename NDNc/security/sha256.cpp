@@ -0,0 +1,449 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define NDNC_SHA256_X86 1
+#endif
+
+#include "sha256.hpp"
+
+namespace ndnc::security {
+namespace {
+alignas(64) const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+const uint32_t H0[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+inline uint32_t loadBE32(const uint8_t *p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+           (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline void storeBE32(uint8_t *p, uint32_t v) {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+}
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+/**
+ * @brief Build the padded last block(s) of a message into tail
+ *
+ * @return size_t The number of padded blocks, 1 or 2
+ */
+size_t padTail(const uint8_t *data, size_t len, uint8_t *tail) {
+    size_t rem = len % 64;
+    size_t blocks = rem < 56 ? 1 : 2;
+
+    memset(tail, 0, blocks * 64);
+    if (rem > 0) {
+        memcpy(tail, data + len - rem, rem);
+    }
+    tail[rem] = 0x80;
+
+    uint64_t bits = uint64_t(len) * 8;
+    storeBE32(tail + blocks * 64 - 8, uint32_t(bits >> 32));
+    storeBE32(tail + blocks * 64 - 4, uint32_t(bits));
+
+    return blocks;
+}
+
+void compressGeneric(uint32_t *state, const uint8_t *data, size_t blocks) {
+    uint32_t w[64];
+
+    for (; blocks > 0; --blocks, data += 64) {
+        for (int t = 0; t < 16; ++t) {
+            w[t] = loadBE32(data + 4 * t);
+        }
+        for (int t = 16; t < 64; ++t) {
+            auto s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^
+                      (w[t - 15] >> 3);
+            auto s1 =
+                rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 64; ++t) {
+            auto t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) +
+                      ((e & f) ^ (~e & g)) + K[t] + w[t];
+            auto t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) +
+                      ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef NDNC_SHA256_X86
+__attribute__((target("sha,sse4.1"))) void
+compressShaNi(uint32_t *state, const uint8_t *data, size_t blocks) {
+    const __m128i mask =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions keep the state as ABEF and CDGH
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        __m128i abef = state0;
+        __m128i cdgh = state1;
+        __m128i w[16];
+
+        for (int i = 0; i < 16; ++i) {
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i *)(data + 16 * i)), mask);
+            } else {
+                w[i] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(w[i - 4], w[i - 3]),
+                                  _mm_alignr_epi8(w[i - 1], w[i - 2], 4)),
+                    w[i - 1]);
+            }
+
+            auto msg = _mm_add_epi32(
+                w[i], _mm_load_si128((const __m128i *)&K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+#define NDNC_ROTR8(x, n)                                                       \
+    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+/**
+ * @brief Hash up to 8 messages, one per AVX2 lane. Lanes run for as many
+ * blocks as the longest message; the state of a lane is frozen once its
+ * own blocks are consumed
+ *
+ */
+__attribute__((target("avx2"))) void
+sha256x8(const uint8_t *const *data, const size_t *len, size_t n,
+         uint8_t *digests) {
+    alignas(32) uint32_t words[16][8];
+    alignas(32) int32_t active[8];
+    alignas(32) uint32_t out[8][8];
+    uint8_t tails[8][128];
+    size_t full[8], total[8];
+    size_t maxBlocks = 0;
+
+    for (size_t l = 0; l < 8; ++l) {
+        full[l] = total[l] = 0;
+        if (l < n) {
+            full[l] = len[l] / 64;
+            total[l] = full[l] + padTail(data[l], len[l], tails[l]);
+            maxBlocks = std::max(maxBlocks, total[l]);
+        }
+    }
+
+    __m256i s[8];
+    for (int i = 0; i < 8; ++i) {
+        s[i] = _mm256_set1_epi32(int32_t(H0[i]));
+    }
+
+    const __m256i bswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15,
+        8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    for (size_t b = 0; b < maxBlocks; ++b) {
+        // Transpose the current block of every lane into 16 word vectors
+        for (size_t l = 0; l < 8; ++l) {
+            const uint8_t *block = nullptr;
+            if (b < full[l]) {
+                block = data[l] + 64 * b;
+            } else if (b < total[l]) {
+                block = tails[l] + 64 * (b - full[l]);
+            }
+
+            active[l] = block != nullptr ? -1 : 0;
+            for (int t = 0; t < 16; ++t) {
+                uint32_t v = 0;
+                if (block != nullptr) {
+                    memcpy(&v, block + 4 * t, 4);
+                }
+                words[t][l] = v;
+            }
+        }
+
+        __m256i w[16];
+        for (int t = 0; t < 16; ++t) {
+            w[t] = _mm256_shuffle_epi8(
+                _mm256_load_si256((const __m256i *)words[t]), bswap);
+        }
+
+        __m256i a = s[0], bb = s[1], c = s[2], d = s[3];
+        __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 64; ++t) {
+            if (t >= 16) {
+                auto w15 = w[(t - 15) & 15];
+                auto w2 = w[(t - 2) & 15];
+                auto s0 = _mm256_xor_si256(
+                    _mm256_xor_si256(NDNC_ROTR8(w15, 7), NDNC_ROTR8(w15, 18)),
+                    _mm256_srli_epi32(w15, 3));
+                auto s1 = _mm256_xor_si256(
+                    _mm256_xor_si256(NDNC_ROTR8(w2, 17), NDNC_ROTR8(w2, 19)),
+                    _mm256_srli_epi32(w2, 10));
+                w[t & 15] = _mm256_add_epi32(
+                    _mm256_add_epi32(w[t & 15], s0),
+                    _mm256_add_epi32(w[(t - 7) & 15], s1));
+            }
+
+            auto sigma1 = _mm256_xor_si256(
+                _mm256_xor_si256(NDNC_ROTR8(e, 6), NDNC_ROTR8(e, 11)),
+                NDNC_ROTR8(e, 25));
+            auto ch = _mm256_xor_si256(_mm256_and_si256(e, f),
+                                       _mm256_andnot_si256(e, g));
+            auto t1 = _mm256_add_epi32(
+                _mm256_add_epi32(_mm256_add_epi32(h, sigma1), ch),
+                _mm256_add_epi32(_mm256_set1_epi32(int32_t(K[t])),
+                                 w[t & 15]));
+
+            auto sigma0 = _mm256_xor_si256(
+                _mm256_xor_si256(NDNC_ROTR8(a, 2), NDNC_ROTR8(a, 13)),
+                NDNC_ROTR8(a, 22));
+            auto maj = _mm256_xor_si256(
+                _mm256_xor_si256(_mm256_and_si256(a, bb),
+                                 _mm256_and_si256(a, c)),
+                _mm256_and_si256(bb, c));
+            auto t2 = _mm256_add_epi32(sigma0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = bb;
+            bb = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        auto mask = _mm256_load_si256((const __m256i *)active);
+        __m256i v[8] = {a, bb, c, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i) {
+            s[i] =
+                _mm256_blendv_epi8(s[i], _mm256_add_epi32(s[i], v[i]), mask);
+        }
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        _mm256_store_si256((__m256i *)out[i], s[i]);
+    }
+
+    for (size_t l = 0; l < n; ++l) {
+        for (int i = 0; i < 8; ++i) {
+            storeBE32(digests + l * SHA256_DIGEST_SIZE + 4 * i, out[i][l]);
+        }
+    }
+}
+
+#undef NDNC_ROTR8
+
+bool cpuHasAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+bool cpuHasShaNi() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+
+    // CPUID.(EAX=7,ECX=0):EBX.SHA[bit 29]
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+}
+#endif // NDNC_SHA256_X86
+
+bool isSupported(Sha256Backend backend) {
+    switch (backend) {
+    case Sha256Backend::generic:
+        return true;
+#ifdef NDNC_SHA256_X86
+    case Sha256Backend::avx2:
+        return cpuHasAvx2();
+    case Sha256Backend::shani:
+        return cpuHasShaNi();
+#endif // NDNC_SHA256_X86
+    default:
+        return false;
+    }
+}
+
+Sha256Backend detectBackend() {
+    if (isSupported(Sha256Backend::shani)) {
+        return Sha256Backend::shani;
+    }
+    if (isSupported(Sha256Backend::avx2)) {
+        return Sha256Backend::avx2;
+    }
+    return Sha256Backend::generic;
+}
+
+std::atomic<Sha256Backend> backend_{detectBackend()};
+
+void sha256One(Sha256Backend backend, const uint8_t *data, size_t len,
+               uint8_t *digest) {
+    uint32_t state[8];
+    memcpy(state, H0, sizeof(state));
+
+    uint8_t tail[128];
+    size_t full = len / 64;
+    size_t tailBlocks = padTail(data, len, tail);
+
+#ifdef NDNC_SHA256_X86
+    if (backend == Sha256Backend::shani) {
+        compressShaNi(state, data, full);
+        compressShaNi(state, tail, tailBlocks);
+    } else
+#endif // NDNC_SHA256_X86
+    {
+        compressGeneric(state, data, full);
+        compressGeneric(state, tail, tailBlocks);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        storeBE32(digest + 4 * i, state[i]);
+    }
+}
+}; // namespace
+
+Sha256Backend getSha256Backend() {
+    return backend_.load(std::memory_order_relaxed);
+}
+
+bool setSha256Backend(Sha256Backend backend) {
+    if (!isSupported(backend)) {
+        return false;
+    }
+
+    backend_.store(backend, std::memory_order_relaxed);
+    return true;
+}
+
+std::string to_string(Sha256Backend backend) {
+    switch (backend) {
+    case Sha256Backend::avx2:
+        return "avx2";
+    case Sha256Backend::shani:
+        return "sha-ni";
+    default:
+        return "generic";
+    }
+}
+
+void sha256(const uint8_t *data, size_t len, uint8_t *digest) {
+    auto backend = getSha256Backend();
+
+    // A single message gains nothing from the AVX2 lanes
+    if (backend == Sha256Backend::avx2) {
+        backend = Sha256Backend::generic;
+    }
+
+    sha256One(backend, data, len, digest);
+}
+
+void sha256Batch(const uint8_t *const *data, const size_t *len, size_t n,
+                 uint8_t *digests) {
+    auto backend = getSha256Backend();
+
+#ifdef NDNC_SHA256_X86
+    if (backend == Sha256Backend::avx2) {
+        size_t i = 0;
+        for (; i + 1 < n; i += 8) {
+            sha256x8(data + i, len + i, std::min<size_t>(8, n - i),
+                     digests + i * SHA256_DIGEST_SIZE);
+        }
+
+        // A lone message is cheaper on the scalar path
+        if (i < n) {
+            sha256One(Sha256Backend::generic, data[i], len[i],
+                      digests + i * SHA256_DIGEST_SIZE);
+        }
+        return;
+    }
+#endif // NDNC_SHA256_X86
+
+    for (size_t i = 0; i < n; ++i) {
+        sha256One(backend, data[i], len[i], digests + i * SHA256_DIGEST_SIZE);
+    }
+}
+}; // namespace ndnc::security
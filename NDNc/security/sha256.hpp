@@ -0,0 +1,77 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_SECURITY_SHA256_HPP
+#define NDNC_SECURITY_SHA256_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ndnc::security {
+static const size_t SHA256_DIGEST_SIZE = 32;
+
+enum class Sha256Backend
+{
+    generic = 0, // Portable scalar code
+    avx2 = 1,    // 8 messages at once in AVX2 lanes
+    shani = 2    // Intel SHA extensions, one message at a time
+};
+
+/**
+ * @brief Get the backend selected at startup from the CPU features. SHA-NI
+ * is preferred over AVX2 since a single SHA-NI stream is already faster than
+ * eight AVX2 lanes on the CPUs that have both
+ *
+ */
+Sha256Backend getSha256Backend();
+
+/**
+ * @brief Force a backend, e.g. for benchmarks
+ *
+ * @return false if the CPU does not support it
+ */
+bool setSha256Backend(Sha256Backend backend);
+
+std::string to_string(Sha256Backend backend);
+
+/**
+ * @brief Compute the SHA-256 digest of one message
+ *
+ */
+void sha256(const uint8_t *data, size_t len, uint8_t *digest);
+
+/**
+ * @brief Compute the SHA-256 digests of n messages. digests must hold
+ * n * SHA256_DIGEST_SIZE bytes
+ *
+ */
+void sha256Batch(const uint8_t *const *data, const size_t *len, size_t n,
+                 uint8_t *digests);
+}; // namespace ndnc::security
+
+#endif // NDNC_SECURITY_SHA256_HPP
@@ -0,0 +1,246 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "http-exporter.hpp"
+#include "logger/logger.hpp"
+#include "registry.hpp"
+
+namespace ndnc {
+namespace telemetry {
+namespace {
+static constexpr char UNIX_PREFIX[] = "unix:";
+
+void sendAll(int fd, const std::string &buffer) {
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        auto n = ::send(fd, buffer.data() + offset, buffer.size() - offset,
+                        MSG_NOSIGNAL);
+        if (n <= 0) {
+            return;
+        }
+        offset += n;
+    }
+}
+
+std::string response(const std::string &status, const std::string &type,
+                     const std::string &body) {
+    return "HTTP/1.1 " + status + "\r\nContent-Type: " + type +
+           "\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+}; // namespace
+
+HttpExporter &HttpExporter::instance() {
+    static HttpExporter exporter;
+    return exporter;
+}
+
+HttpExporter::~HttpExporter() {
+    stop();
+}
+
+bool HttpExporter::start(const std::string &address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (worker_.joinable()) {
+        return true;
+    }
+
+    fd_ = listen(address);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    stop_ = false;
+    worker_ = std::thread(&HttpExporter::run, this);
+
+    LOG_INFO("serving metrics on %s", address.c_str());
+    return true;
+}
+
+void HttpExporter::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!worker_.joinable()) {
+        return;
+    }
+
+    stop_ = true;
+    worker_.join();
+
+    ::close(fd_);
+    fd_ = -1;
+
+    if (!unixPath_.empty()) {
+        ::unlink(unixPath_.c_str());
+        unixPath_.clear();
+    }
+}
+
+int HttpExporter::listen(const std::string &address) {
+    int fd = -1;
+
+    if (address.rfind(UNIX_PREFIX, 0) == 0) {
+        auto path = address.substr(sizeof(UNIX_PREFIX) - 1);
+
+        sockaddr_un addr{};
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+            LOG_ERROR("invalid metrics socket path '%s'", path.c_str());
+            return -1;
+        }
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            LOG_ERROR("metrics socket: %s", std::strerror(errno));
+            return -1;
+        }
+
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) <
+            0) {
+            LOG_ERROR("unable to bind metrics socket %s: %s", path.c_str(),
+                      std::strerror(errno));
+            ::close(fd);
+            return -1;
+        }
+        unixPath_ = path;
+    } else {
+        auto pos = address.rfind(':');
+        if (pos == std::string::npos) {
+            LOG_ERROR("invalid metrics address '%s'", address.c_str());
+            return -1;
+        }
+
+        auto host = address.substr(0, pos);
+        auto port = address.substr(pos + 1);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+
+        addrinfo *result = nullptr;
+        auto err = ::getaddrinfo(host.empty() ? nullptr : host.c_str(),
+                                 port.c_str(), &hints, &result);
+        if (err != 0) {
+            LOG_ERROR("invalid metrics address '%s': %s", address.c_str(),
+                      ::gai_strerror(err));
+            return -1;
+        }
+
+        for (auto ai = result; ai != nullptr; ai = ai->ai_next) {
+            fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC,
+                          ai->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+
+            int on = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+            if (::bind(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+                break;
+            }
+
+            ::close(fd);
+            fd = -1;
+        }
+        ::freeaddrinfo(result);
+
+        if (fd < 0) {
+            LOG_ERROR("unable to bind metrics address %s", address.c_str());
+            return -1;
+        }
+    }
+
+    if (::listen(fd, 16) < 0) {
+        LOG_ERROR("unable to listen on metrics address %s: %s",
+                  address.c_str(), std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+void HttpExporter::run() {
+    pollfd pfd{fd_, POLLIN, 0};
+
+    while (!stop_) {
+        if (::poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+
+        int client = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+
+        serve(client);
+        ::close(client);
+    }
+}
+
+void HttpExporter::serve(int fd) {
+    timeval timeout{1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < 8192) {
+        auto n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        request.append(buffer, n);
+    }
+
+    auto line = request.substr(0, request.find("\r\n"));
+    auto path = line.substr(0, line.find(' ', 4));
+    path = path.substr(0, path.find('?'));
+
+    if (path == "GET /metrics") {
+        sendAll(fd, response("200 OK", "text/plain; version=0.0.4",
+                             Registry::instance().collect()));
+    } else {
+        sendAll(fd, response("404 Not Found", "text/plain", "not found\n"));
+    }
+}
+}; // namespace telemetry
+}; // namespace ndnc
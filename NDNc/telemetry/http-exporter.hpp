@@ -0,0 +1,77 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_TELEMETRY_HTTP_EXPORTER_HPP
+#define NDNC_TELEMETRY_HTTP_EXPORTER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ndnc {
+namespace telemetry {
+/**
+ * @brief Minimal HTTP server answering GET /metrics with the content of the
+ * metrics registry. It serves one connection at a time on its own thread so
+ * scrapes never touch the data path
+ *
+ */
+class HttpExporter {
+  public:
+    static HttpExporter &instance();
+
+    ~HttpExporter();
+
+    /**
+     * @brief Start listening, unless already started
+     *
+     * @param address Either "host:port", ":port" or "unix:/path/to/socket"
+     * @return true if the exporter is listening
+     */
+    bool start(const std::string &address);
+
+    void stop();
+
+  private:
+    HttpExporter() = default;
+
+    int listen(const std::string &address);
+    void run();
+    void serve(int fd);
+
+  private:
+    std::mutex mutex_;
+    std::thread worker_;
+    std::atomic_bool stop_{false};
+    int fd_ = -1;
+    std::string unixPath_;
+};
+}; // namespace telemetry
+}; // namespace ndnc
+
+#endif // NDNC_TELEMETRY_HTTP_EXPORTER_HPP
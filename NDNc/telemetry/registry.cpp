@@ -0,0 +1,190 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+#include <sstream>
+
+#include "registry.hpp"
+
+namespace ndnc {
+namespace telemetry {
+namespace {
+std::string escape(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (auto c : value) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+std::string format(const MetricsWriter::Labels &labels,
+                   const std::string &extra = "") {
+    if (labels.empty() && extra.empty()) {
+        return "";
+    }
+
+    std::string out = "{";
+    for (auto &label : labels) {
+        if (out.size() > 1) {
+            out += ",";
+        }
+        out += label.first + "=\"" + escape(label.second) + "\"";
+    }
+
+    if (!extra.empty()) {
+        if (out.size() > 1) {
+            out += ",";
+        }
+        out += extra;
+    }
+
+    return out + "}";
+}
+
+std::string format(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+
+    std::ostringstream os;
+    os.precision(12);
+    os << value;
+    return os.str();
+}
+}; // namespace
+
+MetricsWriter::Family &MetricsWriter::getFamily(const std::string &name,
+                                                const std::string &type,
+                                                const std::string &help) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        order_.push_back(name);
+        it = families_.emplace(name, Family{type, help, ""}).first;
+    }
+    return it->second;
+}
+
+void MetricsWriter::counter(const std::string &name, const std::string &help,
+                            const Labels &labels, uint64_t value) {
+    // In the text format the HELP and TYPE name matches the sample name
+    auto total = name + "_total";
+    getFamily(total, "counter", help).samples +=
+        total + format(labels) + " " + std::to_string(value) + "\n";
+}
+
+void MetricsWriter::gauge(const std::string &name, const std::string &help,
+                          const Labels &labels, double value) {
+    getFamily(name, "gauge", help).samples +=
+        name + format(labels) + " " + format(value) + "\n";
+}
+
+void MetricsWriter::histogram(const std::string &name,
+                              const std::string &help, const Labels &labels,
+                              const Histogram &histogram, double scale,
+                              uint64_t sum) {
+    auto &family = getFamily(name, "histogram", help);
+
+    // Power-of-two bounds from 1us to about 8s, in recorded units
+    for (int i = 0; i < 24; ++i) {
+        auto bound =
+            static_cast<uint64_t>(std::llround(std::ldexp(1e-6, i) / scale));
+        family.samples +=
+            name + "_bucket" +
+            format(labels, "le=\"" + format(bound * scale) + "\"") + " " +
+            std::to_string(histogram.getCountAtOrBelow(bound)) + "\n";
+    }
+
+    family.samples += name + "_bucket" + format(labels, "le=\"+Inf\"") + " " +
+                      std::to_string(histogram.getCount()) + "\n";
+    family.samples +=
+        name + "_sum" + format(labels) + " " + format(sum * scale) + "\n";
+    family.samples += name + "_count" + format(labels) + " " +
+                      std::to_string(histogram.getCount()) + "\n";
+}
+
+std::string MetricsWriter::str() const {
+    std::string out;
+
+    for (auto &name : order_) {
+        auto &family = families_.at(name);
+        out += "# HELP " + name + " " + family.help + "\n";
+        out += "# TYPE " + name + " " + family.type + "\n";
+        out += family.samples;
+    }
+
+    return out;
+}
+
+Registry &Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+uint64_t Registry::add(Collector collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    collectors_.emplace(++nextHandle_, std::move(collector));
+    return nextHandle_;
+}
+
+void Registry::remove(uint64_t handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors_.erase(handle);
+}
+
+uint64_t Registry::nextInstanceId() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextInstanceId_++;
+}
+
+std::string Registry::collect() {
+    MetricsWriter writer;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &collector : collectors_) {
+        collector.second(writer);
+    }
+
+    return writer.str();
+}
+}; // namespace telemetry
+}; // namespace ndnc
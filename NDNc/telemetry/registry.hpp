@@ -0,0 +1,137 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_TELEMETRY_REGISTRY_HPP
+#define NDNC_TELEMETRY_REGISTRY_HPP
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/histogram.hpp"
+
+namespace ndnc {
+namespace telemetry {
+/**
+ * @brief Render metrics in the Prometheus text exposition format. Samples of
+ * the same metric coming from several collectors are grouped under a single
+ * HELP and TYPE header
+ *
+ */
+class MetricsWriter {
+  public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Write a counter. The metric is exposed as name_total
+     *
+     */
+    void counter(const std::string &name, const std::string &help,
+                 const Labels &labels, uint64_t value);
+
+    void gauge(const std::string &name, const std::string &help,
+               const Labels &labels, double value);
+
+    /**
+     * @brief Write a histogram with power-of-two buckets
+     *
+     * @param scale Multiplier from recorded values to the exposed unit, e.g.
+     * 1e-9 for values recorded in nanoseconds and exposed in seconds
+     * @param sum Exact sum of the recorded values
+     */
+    void histogram(const std::string &name, const std::string &help,
+                   const Labels &labels, const Histogram &histogram,
+                   double scale, uint64_t sum);
+
+    std::string str() const;
+
+  private:
+    struct Family {
+        std::string type;
+        std::string help;
+        std::string samples;
+    };
+
+    Family &getFamily(const std::string &name, const std::string &type,
+                      const std::string &help);
+
+  private:
+    std::vector<std::string> order_;
+    std::unordered_map<std::string, Family> families_;
+};
+
+/**
+ * @brief Process-wide set of metric collectors. Collectors run only when the
+ * metrics are scraped and should read values maintained on the data path
+ * with relaxed atomics
+ *
+ */
+class Registry {
+  public:
+    using Collector = std::function<void(MetricsWriter &)>;
+
+    static Registry &instance();
+
+    /**
+     * @brief Add a collector
+     *
+     * @return uint64_t The handle to remove it with
+     */
+    uint64_t add(Collector collector);
+
+    /**
+     * @brief Remove a collector. Once this returns the collector is not
+     * running and will not run again
+     *
+     */
+    void remove(uint64_t handle);
+
+    /**
+     * @brief Get a process-unique number to label an instance with
+     *
+     */
+    uint64_t nextInstanceId();
+
+    std::string collect();
+
+  private:
+    Registry() = default;
+
+  private:
+    std::mutex mutex_;
+    std::map<uint64_t, Collector> collectors_;
+    uint64_t nextHandle_ = 0;
+    uint64_t nextInstanceId_ = 0;
+};
+}; // namespace telemetry
+}; // namespace ndnc
+
+#endif // NDNC_TELEMETRY_REGISTRY_HPP
@@ -0,0 +1,268 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <fstream>
+
+#include "logger/logger.hpp"
+#include "registry.hpp"
+#include "tracer.hpp"
+
+namespace ndnc {
+namespace telemetry {
+namespace {
+// Spans waiting for a consumer that never pops are dropped past this limit
+static constexpr size_t MAX_AWAITING_PICKUPS = 65536;
+
+std::string escapeJson(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (auto c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+
+    return escaped;
+}
+}; // namespace
+
+Tracer &Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() {
+    metricsHandle_ = Registry::instance().add([this](MetricsWriter &writer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (sampleEvery_ == 0 && stages_[total].getCount() == 0) {
+            return;
+        }
+
+        for (int i = 0; i < stageCount; ++i) {
+            writer.histogram("ndnc_trace_stage_seconds",
+                             "Latency of the sampled Interests by stage",
+                             {{"stage", getStageName(static_cast<Stage>(i))}},
+                             stages_[i], 1e-9, sums_[i]);
+        }
+    });
+}
+
+Tracer::~Tracer() {
+    Registry::instance().remove(metricsHandle_);
+}
+
+void Tracer::start(size_t sampleEvery, size_t maxSpans) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    maxSpans_ = maxSpans;
+    spans_.reserve(std::min<size_t>(maxSpans_, 4096));
+    sampleEvery_ = sampleEvery;
+
+    LOG_INFO("tracing one in every %zu Interests", sampleEvery);
+}
+
+void Tracer::stop() {
+    sampleEvery_ = 0;
+}
+
+void Tracer::awaitPickup(const void *data, std::shared_ptr<TraceSpan> span) {
+    span->mark(TraceSpan::delivered);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (pickups_.size() >= MAX_AWAITING_PICKUPS) {
+        droppedSpans_ += pickups_.size();
+        pickups_.clear();
+    }
+
+    pickups_[data] = std::move(span);
+    awaiting_.store(pickups_.size(), std::memory_order_relaxed);
+}
+
+void Tracer::complete(const void *data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = pickups_.find(data);
+    if (it == pickups_.end()) {
+        return;
+    }
+
+    auto span = std::move(it->second);
+    pickups_.erase(it);
+    awaiting_.store(pickups_.size(), std::memory_order_relaxed);
+
+    span->mark(TraceSpan::pickedUp);
+    record(*span);
+}
+
+void Tracer::record(const TraceSpan &span) {
+    auto &ts = span.ts;
+    auto elapsed = [&](TraceSpan::Event from, TraceSpan::Event to) {
+        return ts[to] > ts[from] ? ts[to] - ts[from] : 0;
+    };
+
+    std::array<uint64_t, stageCount> durations{
+        elapsed(TraceSpan::enqueued, TraceSpan::dequeued),
+        elapsed(TraceSpan::dequeued, TraceSpan::firstTx),
+        elapsed(TraceSpan::firstTx, TraceSpan::lastTx),
+        elapsed(TraceSpan::lastTx, TraceSpan::rx),
+        elapsed(TraceSpan::rx, TraceSpan::delivered),
+        elapsed(TraceSpan::delivered, TraceSpan::pickedUp),
+        elapsed(TraceSpan::enqueued, TraceSpan::pickedUp)};
+
+    for (int i = 0; i < stageCount; ++i) {
+        stages_[i].record(durations[i]);
+        sums_[i] += durations[i];
+    }
+
+    if (spans_.size() < maxSpans_) {
+        spans_.push_back(span);
+    } else {
+        ++droppedSpans_;
+    }
+}
+
+Histogram Tracer::getStageHistogram(Stage stage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stages_[stage];
+}
+
+const char *Tracer::getStageName(Stage stage) {
+    switch (stage) {
+    case queue:
+        return "queue";
+    case dispatch:
+        return "dispatch";
+    case retransmission:
+        return "retransmission";
+    case network:
+        return "network";
+    case delivery:
+        return "delivery";
+    case pickup:
+        return "pickup";
+    case total:
+        return "total";
+    default:
+        return "unknown";
+    }
+}
+
+void Tracer::logSummary() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (stages_[total].getCount() == 0) {
+        return;
+    }
+
+    LOG_INFO("trace summary: %lu sampled Interests",
+             stages_[total].getCount());
+
+    for (int i = 0; i < stageCount; ++i) {
+        auto &h = stages_[i];
+        LOG_INFO("trace stage=%s p50=%luus p99=%luus max=%luus",
+                 getStageName(static_cast<Stage>(i)),
+                 h.getValueAtPercentile(50) / 1000,
+                 h.getValueAtPercentile(99) / 1000, h.getMax() / 1000);
+    }
+}
+
+bool Tracer::writeChromeTrace(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("unable to open trace file %s", path.c_str());
+        return false;
+    }
+
+    // Nestable async events: one track per span, with the stages nested
+    // under the whole Interest lifetime. Timestamps are in microseconds
+    static constexpr std::array<std::pair<TraceSpan::Event, TraceSpan::Event>,
+                                stageCount - 1>
+        bounds{{{TraceSpan::enqueued, TraceSpan::dequeued},
+                {TraceSpan::dequeued, TraceSpan::firstTx},
+                {TraceSpan::firstTx, TraceSpan::lastTx},
+                {TraceSpan::lastTx, TraceSpan::rx},
+                {TraceSpan::rx, TraceSpan::delivered},
+                {TraceSpan::delivered, TraceSpan::pickedUp}}};
+
+    bool first = true;
+    auto event = [&](const char *name, const char *phase, uint64_t id,
+                     uint64_t tid, uint64_t ts, const std::string &args) {
+        out << (first ? "\n" : ",\n") << "{\"name\":\"" << name
+            << "\",\"cat\":\"ndnc\",\"ph\":\"" << phase
+            << "\",\"id\":" << id << ",\"pid\":1,\"tid\":" << tid
+            << ",\"ts\":" << ts / 1000 << "." << (ts % 1000) / 100
+            << (ts % 100) / 10 << ts % 10;
+        if (!args.empty()) {
+            out << ",\"args\":{" << args << "}";
+        }
+        out << "}";
+        first = false;
+    };
+
+    out << "{\"traceEvents\":[";
+    for (auto &span : spans_) {
+        auto &ts = span.ts;
+        auto args = "\"name\":\"" + escapeJson(span.name) +
+                    "\",\"transmissions\":" +
+                    std::to_string(span.transmissions);
+
+        event("interest", "b", span.id, span.consumerId,
+              ts[TraceSpan::enqueued], args);
+
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            auto from = ts[bounds[i].first], to = ts[bounds[i].second];
+            if (from == 0 || to <= from) {
+                continue;
+            }
+
+            auto name = getStageName(static_cast<Stage>(i));
+            event(name, "b", span.id, span.consumerId, from, "");
+            event(name, "e", span.id, span.consumerId, to, "");
+        }
+
+        event("interest", "e", span.id, span.consumerId,
+              ts[TraceSpan::pickedUp], "");
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    if (!out) {
+        LOG_ERROR("unable to write trace file %s", path.c_str());
+        return false;
+    }
+
+    LOG_INFO("wrote %zu spans to %s (%lu dropped)", spans_.size(),
+             path.c_str(), droppedSpans_);
+    return true;
+}
+}; // namespace telemetry
+}; // namespace ndnc
@@ -0,0 +1,217 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_TELEMETRY_TRACER_HPP
+#define NDNC_TELEMETRY_TRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/histogram.hpp"
+
+namespace ndnc {
+namespace telemetry {
+/**
+ * @brief Timestamps of one sampled Interest, from the moment a consumer
+ * pushes it to the moment the consumer pops its Data. Each timestamp is
+ * written by a single thread; the pipeline queues order the writes
+ *
+ */
+struct TraceSpan {
+    enum Event
+    {
+        // Pushed to the request queue by a consumer
+        enqueued = 0,
+        // Popped from the request queue by the pipeline worker
+        dequeued,
+        // First and last transmission
+        firstTx,
+        lastTx,
+        // Data received for the last transmission
+        rx,
+        // Data handed to the response queue, once verified if enabled
+        delivered,
+        // Data popped from the response queue by the consumer
+        pickedUp,
+        count
+    };
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void mark(Event event) {
+        if (ts[event] == 0) {
+            ts[event] = now();
+        }
+    }
+
+    void markTx() {
+        ts[lastTx] = now();
+        if (ts[firstTx] == 0) {
+            ts[firstTx] = ts[lastTx];
+        }
+        ++transmissions;
+    }
+
+    uint64_t id = 0;
+    uint64_t consumerId = 0;
+    std::string name;
+    uint32_t transmissions = 0;
+    std::array<uint64_t, count> ts{};
+};
+
+/**
+ * @brief Process-wide sampling tracer. One in every N Interests carries a
+ * TraceSpan through the pipeline; completed spans are aggregated into one
+ * latency histogram per stage and kept for a Chrome trace export
+ *
+ */
+class Tracer {
+  public:
+    enum Stage
+    {
+        // Request queue and congestion window
+        queue = 0,
+        // Dequeue to first transmission
+        dispatch,
+        // First to last transmission, zero unless retransmitted
+        retransmission,
+        // Last transmission to Data
+        network,
+        // Verification and response queue hand-off
+        delivery,
+        // Waiting in the response queue for the consumer
+        pickup,
+        // Enqueue to pickup
+        total,
+        stageCount
+    };
+
+    static Tracer &instance();
+
+    /**
+     * @brief Start sampling one in every sampleEvery Interests
+     *
+     * @param maxSpans Completed spans kept for the trace export. Statistics
+     * keep being collected once the limit is reached
+     */
+    void start(size_t sampleEvery, size_t maxSpans = 100000);
+
+    void stop();
+
+    /**
+     * @brief Get a new span if this Interest is sampled, nullptr otherwise.
+     * Costs a relaxed load when tracing is disabled
+     *
+     */
+    std::shared_ptr<TraceSpan> sample(uint64_t consumerId) {
+        auto every = sampleEvery_.load(std::memory_order_relaxed);
+        if (every == 0) {
+            return nullptr;
+        }
+
+        thread_local uint64_t counter = 0;
+        if (++counter % every != 0) {
+            return nullptr;
+        }
+
+        auto span = std::make_shared<TraceSpan>();
+        span->id = nextSpanId_.fetch_add(1, std::memory_order_relaxed);
+        span->consumerId = consumerId;
+        span->mark(TraceSpan::enqueued);
+        return span;
+    }
+
+    /**
+     * @brief Wait for the consumer to pop the Data packet of the span
+     *
+     */
+    void awaitPickup(const void *data, std::shared_ptr<TraceSpan> span);
+
+    /**
+     * @brief Complete the span of a Data packet, if any. Costs a relaxed
+     * load when no sampled packet is waiting
+     *
+     */
+    void onPickup(const void *data) {
+        if (awaiting_.load(std::memory_order_relaxed) > 0) {
+            complete(data);
+        }
+    }
+
+    Histogram getStageHistogram(Stage stage);
+
+    static const char *getStageName(Stage stage);
+
+    /**
+     * @brief Log the median and tail latency of every stage
+     *
+     */
+    void logSummary();
+
+    /**
+     * @brief Write the kept spans as Chrome trace JSON, which can be opened
+     * in chrome://tracing or Perfetto
+     *
+     * @return false if the file could not be written
+     */
+    bool writeChromeTrace(const std::string &path);
+
+  private:
+    Tracer();
+    ~Tracer();
+
+    void complete(const void *data);
+    void record(const TraceSpan &span);
+
+  private:
+    std::atomic_size_t sampleEvery_{0};
+    std::atomic_uint64_t nextSpanId_{0};
+    std::atomic_size_t awaiting_{0};
+
+    std::mutex mutex_;
+    std::unordered_map<const void *, std::shared_ptr<TraceSpan>> pickups_;
+    std::vector<TraceSpan> spans_;
+    size_t maxSpans_ = 0;
+    uint64_t droppedSpans_ = 0;
+    std::array<Histogram, stageCount> stages_;
+    std::array<uint64_t, stageCount> sums_{};
+    uint64_t metricsHandle_ = 0;
+};
+}; // namespace telemetry
+}; // namespace ndnc
+
+#endif // NDNC_TELEMETRY_TRACER_HPP
@@ -0,0 +1,203 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_UTILS_HISTOGRAM_HPP
+#define NDNC_UTILS_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ndnc {
+/**
+ * @brief Log-linear histogram in the style of HdrHistogram. Values below
+ * 2^precision are counted exactly; larger values share a bucket with the
+ * ones having the same 'precision' most significant bits, which bounds the
+ * relative error to 2^-precision over the whole uint64_t range
+ *
+ */
+class Histogram {
+  public:
+    explicit Histogram(unsigned precision = 7)
+        : precision_{std::min(std::max(precision, 1u), 16u)},
+          counts_((64 - precision_ + 1) << precision_, 0) {
+        reset();
+    }
+
+    void record(uint64_t value, uint64_t count = 1) {
+        counts_[getIndex(value)] += count;
+        count_ += count;
+        sum_ += value * count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief Add the recorded values of another histogram of the same
+     * precision
+     *
+     */
+    void merge(const Histogram &other) {
+        if (other.precision_ != precision_) {
+            return;
+        }
+
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /**
+     * @brief Add counts kept elsewhere under the same bucket layout, e.g. in
+     * per-thread atomic arrays. Values are taken as the bucket's highest
+     *
+     */
+    void recordBucket(size_t index, uint64_t count) {
+        if (index >= counts_.size() || count == 0) {
+            return;
+        }
+
+        auto value = getHighestValue(index);
+
+        counts_[index] += count;
+        count_ += count;
+        sum_ += value * count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    uint64_t getCount() const {
+        return count_;
+    }
+
+    uint64_t getMin() const {
+        return count_ == 0 ? 0 : min_;
+    }
+
+    uint64_t getMax() const {
+        return max_;
+    }
+
+    double getMean() const {
+        return count_ == 0 ? 0 : static_cast<double>(sum_) / count_;
+    }
+
+    /**
+     * @brief Get the highest value equivalent to the one at the given
+     * percentile, clamped to the recorded min and max
+     *
+     * @param percentile A value between 0 and 100
+     */
+    uint64_t getValueAtPercentile(double percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+
+        percentile = std::min(std::max(percentile, 0.0), 100.0);
+        auto rank = static_cast<uint64_t>(percentile / 100.0 * count_ + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return std::min(std::max(getHighestValue(i), min_), max_);
+            }
+        }
+
+        return max_;
+    }
+
+    /**
+     * @brief Get the number of recorded values whose bucket lies entirely at
+     * or below the given value, e.g. for cumulative exposition buckets
+     *
+     */
+    uint64_t getCountAtOrBelow(uint64_t value) const {
+        uint64_t count = 0;
+        for (size_t i = 0; i < counts_.size() && getHighestValue(i) <= value;
+             ++i) {
+            count += counts_[i];
+        }
+        return count;
+    }
+
+    size_t getBucketCount() const {
+        return counts_.size();
+    }
+
+    size_t getIndex(uint64_t value) const {
+        if (value < (uint64_t{1} << precision_)) {
+            return value;
+        }
+
+        unsigned msb = 63 - __builtin_clzll(value);
+        unsigned shift = msb - precision_;
+        uint64_t sub = (value >> shift) - (uint64_t{1} << precision_);
+
+        return ((shift + 1) << precision_) + sub;
+    }
+
+  private:
+    uint64_t getHighestValue(size_t index) const {
+        size_t group = index >> precision_;
+        uint64_t sub = index & ((uint64_t{1} << precision_) - 1);
+
+        if (group == 0) {
+            return sub;
+        }
+
+        auto shift = group - 1;
+        auto lowest = (sub + (uint64_t{1} << precision_)) << shift;
+        return lowest + ((uint64_t{1} << shift) - 1);
+    }
+
+  private:
+    unsigned precision_;
+    std::vector<uint64_t> counts_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+}; // namespace ndnc
+
+#endif // NDNC_UTILS_HISTOGRAM_HPP
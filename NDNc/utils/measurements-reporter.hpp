@@ -28,33 +28,79 @@
 #ifndef NDNC_UTILS_MEASUREMENTS_REPORTER_HPP
 #define NDNC_UTILS_MEASUREMENTS_REPORTER_HPP
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <limits.h>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <unistd.h>
 
 #include <InfluxDBFactory.h>
 
 #include "logger/logger.hpp"
+#include "utils/histogram.hpp"
 
 namespace ndnc {
+/**
+ * @brief Aggregates measurements recorded on the data path and submits them
+ * to InfluxDB from a background thread. Recording only increments relaxed
+ * atomics in a per-thread stripe; the sampling thread collects the stripes
+ * at a fixed interval and writes one point per interval with the rates and
+ * the latency distribution of that interval
+ *
+ */
 class MeasurementsReporter {
   public:
-    MeasurementsReporter(std::size_t batch_size = 128, std::string other = "") {
-        this->influxdb_ = nullptr;
-        this->batch_size_ = batch_size;
-        this->hostname_ = "";
-        this->id_ = "";
-        this->other_ = other;
+    /**
+     * @brief Cumulative counters read at each interval, e.g. from the
+     * consumer pipeline
+     *
+     */
+    struct Sample {
+        int64_t tx = 0;
+        int64_t rx = 0;
+        int64_t delayMsec = 0;
+    };
+
+    using Sampler = std::function<Sample()>;
+
+  private:
+    static constexpr size_t STRIPES = 16;
+    static constexpr unsigned LATENCY_PRECISION = 3;
+
+    struct alignas(64) Stripe {
+        std::atomic_uint64_t ops{0};
+        std::atomic_uint64_t bytes{0};
+        std::unique_ptr<std::atomic_uint64_t[]> latency;
+    };
+
+  public:
+    MeasurementsReporter(std::size_t batch_size = 16, std::string other = "",
+                         std::chrono::milliseconds interval =
+                             std::chrono::seconds{1})
+        : influxdb_{nullptr}, batch_size_{batch_size}, hostname_{""}, id_{""},
+          other_{other}, interval_{interval}, latencyLayout_{LATENCY_PRECISION},
+          running_{false} {
+
+        for (auto &stripe : stripes_) {
+            stripe.latency = std::make_unique<std::atomic_uint64_t[]>(
+                latencyLayout_.getBucketCount());
+        }
     }
 
     ~MeasurementsReporter() {
+        stop();
+
         if (influxdb_ != nullptr) {
             influxdb_->flushBatch();
             influxdb_.release();
         }
     }
 
-    bool init(std::string id, std::string url) {
+    bool init(std::string id, std::string url, Sampler sampler = nullptr) {
         try {
             influxdb_ = influxdb::InfluxDBFactory::Get(url);
         } catch (...) {
@@ -81,34 +127,145 @@ class MeasurementsReporter {
             this->id_ = hostname_ + "_" + id + "_" + std::to_string(getpid());
         }
 
+        sampler_ = sampler;
+        running_ = true;
+        worker_ = std::thread(&MeasurementsReporter::run, this);
+
         return true;
     }
 
-    void write(int64_t tx, int64_t rx, int64_t bytes, int64_t msec) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    /**
+     * @brief Record a completed operation. Lock-free and does no I/O
+     *
+     */
+    void record(uint64_t bytes) {
+        if (!running_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto &stripe = getStripe();
+        stripe.ops.fetch_add(1, std::memory_order_relaxed);
+        stripe.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
 
-        if (this->influxdb_ == nullptr) {
+    void record(uint64_t bytes, std::chrono::nanoseconds latency) {
+        if (!running_.load(std::memory_order_relaxed)) {
             return;
         }
 
-        this->influxdb_->write(influxdb::Point{"ndnc_consumer"}
-                                   .addField("tx", tx)
-                                   .addField("rx", rx)
-                                   .addField("bytes", bytes)
-                                   .addField("mean_delay_msec", msec)
-                                   .addField("id", id_)
-                                   .addField("other", other_)
-                                   .addTag("id", id_)
-                                   .addTag("hostname", hostname_));
+        auto &stripe = getStripe();
+        stripe.ops.fetch_add(1, std::memory_order_relaxed);
+        stripe.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        stripe.latency[latencyLayout_.getIndex(latency.count())].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+  private:
+    Stripe &getStripe() {
+        static std::atomic_size_t next{0};
+        thread_local size_t index = next.fetch_add(1) % STRIPES;
+        return stripes_[index];
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    void run() {
+        auto last = std::chrono::steady_clock::now();
+
+        while (true) {
+            bool running;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait_for(lock, interval_, [this] { return !running_; });
+                running = running_;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            submit(std::chrono::duration<double>(now - last).count());
+            last = now;
+
+            if (!running) {
+                return;
+            }
+        }
+    }
+
+    void submit(double seconds) {
+        uint64_t ops = 0, bytes = 0;
+        Histogram latency{LATENCY_PRECISION};
+
+        for (auto &stripe : stripes_) {
+            ops += stripe.ops.exchange(0, std::memory_order_relaxed);
+            bytes += stripe.bytes.exchange(0, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < latency.getBucketCount(); ++i) {
+                if (stripe.latency[i].load(std::memory_order_relaxed) > 0) {
+                    latency.recordBucket(
+                        i, stripe.latency[i].exchange(
+                               0, std::memory_order_relaxed));
+                }
+            }
+        }
+
+        // Nothing happened in this interval
+        if (ops == 0) {
+            return;
+        }
+
+        auto sample = sampler_ != nullptr ? sampler_() : Sample{};
+        seconds = seconds > 0 ? seconds : 1;
+
+        auto point =
+            influxdb::Point{"ndnc_consumer"}
+                .addField("tx", sample.tx)
+                .addField("rx", sample.rx)
+                .addField("bytes", static_cast<int64_t>(bytes))
+                .addField("mean_delay_msec", sample.delayMsec)
+                .addField("ops", static_cast<int64_t>(ops))
+                .addField("bytes_per_sec", bytes / seconds)
+                .addField("ops_per_sec", ops / seconds);
+
+        if (latency.getCount() > 0) {
+            point.addField("latency_p50_usec",
+                           latency.getValueAtPercentile(50) / 1e3)
+                .addField("latency_p99_usec",
+                          latency.getValueAtPercentile(99) / 1e3)
+                .addField("latency_max_usec", latency.getMax() / 1e3);
+        }
+
+        influxdb_->write(std::move(point.addField("id", id_)
+                                       .addField("other", other_)
+                                       .addTag("id", id_)
+                                       .addTag("hostname", hostname_)));
     }
 
   private:
-    std::mutex mutex_;
     std::unique_ptr<influxdb::InfluxDB> influxdb_;
     std::size_t batch_size_;
     std::string hostname_;
     std::string id_;
     std::string other_;
+
+    std::chrono::milliseconds interval_;
+    Sampler sampler_;
+    Histogram latencyLayout_;
+    Stripe stripes_[STRIPES];
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic_bool running_;
+    std::thread worker_;
 };
 }; // namespace ndnc
 
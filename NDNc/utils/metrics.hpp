@@ -0,0 +1,133 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_UTILS_METRICS_HPP
+#define NDNC_UTILS_METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "utils/histogram.hpp"
+
+namespace ndnc {
+namespace metrics {
+/**
+ * @brief Monotonic counter updated by a single thread and read from any
+ * thread. Updates are a relaxed load and store, without a locked instruction
+ *
+ */
+class Counter {
+  public:
+    Counter &operator++() {
+        return *this += 1;
+    }
+
+    Counter &operator+=(uint64_t n) {
+        value_.store(value_.load(std::memory_order_relaxed) + n,
+                     std::memory_order_relaxed);
+        return *this;
+    }
+
+    uint64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic_uint64_t value_{0};
+};
+
+class Gauge {
+  public:
+    void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic_int64_t value_{0};
+};
+
+/**
+ * @brief Histogram updated by a single thread and read from any thread,
+ * with the bucket layout of ndnc::Histogram
+ *
+ */
+class AtomicHistogram {
+  public:
+    explicit AtomicHistogram(unsigned precision = 5)
+        : layout_{precision},
+          counts_{std::make_unique<std::atomic_uint64_t[]>(
+              layout_.getBucketCount())} {
+    }
+
+    void record(uint64_t value) {
+        auto &count = counts_[layout_.getIndex(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+
+        sum_.store(sum_.load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy the counts recorded so far. Values are rounded to the
+     * highest of their bucket
+     *
+     */
+    Histogram snapshot() const {
+        Histogram histogram{layout_};
+        histogram.reset();
+
+        for (size_t i = 0; i < layout_.getBucketCount(); ++i) {
+            histogram.recordBucket(
+                i, counts_[i].load(std::memory_order_relaxed));
+        }
+
+        return histogram;
+    }
+
+    /**
+     * @brief Get the exact sum of the recorded values
+     *
+     */
+    uint64_t getSum() const {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    Histogram layout_;
+    std::unique_ptr<std::atomic_uint64_t[]> counts_;
+    std::atomic_uint64_t sum_{0};
+};
+}; // namespace metrics
+}; // namespace ndnc
+
+#endif // NDNC_UTILS_METRICS_HPP